@@ -0,0 +1,136 @@
+// meirshuker15@gmail.com
+//ArenaAllocator.hpp
+//Description: A monotonic arena and a matching standard allocator.
+//Used with MyContainer<T, ArenaAllocator<T>> so that short-lived containers and their
+//iterator snapshots take memory from a bump-pointer arena that is released in bulk.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace container {
+
+    /// @brief A bump-pointer arena that only frees its memory all at once.
+    /// @details Allocation is a pointer increment inside the current block; deallocation is a
+    ///          no-op. Call release() once nothing allocated from the arena is in use anymore.
+    class MonotonicArena {
+    private:
+        /// @brief Every block obtained from the global allocator, freed by release().
+        std::vector<void*> blocks;
+        char* cursor = nullptr;
+        size_t remaining = 0;
+        size_t initial_block_size;
+        size_t next_block_size;
+        /// @brief The size of the most recent (largest) block.
+        size_t last_block_size = 0;
+
+    public:
+        /// @brief Constructs an arena.
+        /// @param initial_block_size The size of the first block; later blocks double in size.
+        explicit MonotonicArena(size_t initial_block_size = 64 * 1024)
+            : initial_block_size(initial_block_size), next_block_size(initial_block_size) {}
+
+        MonotonicArena(const MonotonicArena&) = delete;
+        MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+        ~MonotonicArena() { release(); }
+
+        /// @brief Allocates memory from the current block, starting a new block if needed.
+        /// @param bytes The number of bytes to allocate.
+        /// @param alignment The required alignment (a power of two).
+        void* allocate(size_t bytes, size_t alignment) {
+            size_t padding = (alignment - reinterpret_cast<size_t>(cursor) % alignment) % alignment;
+            if (cursor == nullptr || padding + bytes > remaining) {
+                size_t block_size = next_block_size;
+                while (block_size < bytes + alignment) {
+                    block_size *= 2;
+                }
+                next_block_size = block_size * 2;
+                cursor = static_cast<char*>(::operator new(block_size));
+                blocks.push_back(cursor);
+                remaining = block_size;
+                last_block_size = block_size;
+                padding = (alignment - reinterpret_cast<size_t>(cursor) % alignment) % alignment;
+            }
+            void* result = cursor + padding;
+            cursor += padding + bytes;
+            remaining -= padding + bytes;
+            return result;
+        }
+
+        /// @brief Frees every block at once. Everything allocated from the arena becomes invalid.
+        void release() {
+            for (void* block : blocks) {
+                ::operator delete(block);
+            }
+            blocks.clear();
+            cursor = nullptr;
+            remaining = 0;
+            next_block_size = initial_block_size;
+            last_block_size = 0;
+        }
+
+        /// @brief Rewinds the arena for reuse, keeping only its largest block.
+        /// @details Everything allocated from the arena becomes invalid. Steady-state request
+        ///          loops that reset once per request stop touching the global allocator.
+        void reset() {
+            if (blocks.empty()) return;
+            void* largest = blocks.back();
+            blocks.pop_back();
+            for (void* block : blocks) {
+                ::operator delete(block);
+            }
+            blocks.clear();
+            blocks.push_back(largest);
+            cursor = static_cast<char*>(largest);
+            remaining = last_block_size;
+        }
+
+        /// @brief Gets the number of blocks currently held.
+        size_t block_count() const { return blocks.size(); }
+
+        /// @brief Gets the calling thread's default arena.
+        static MonotonicArena& thread_local_arena() {
+            static thread_local MonotonicArena arena;
+            return arena;
+        }
+    };
+
+    /// @brief A standard allocator that takes its memory from a MonotonicArena.
+    /// @details Defaults to the calling thread's arena. Memory is only returned when the
+    ///          arena is released, so use it for short-lived, request-scoped containers.
+    /// @tparam T The type of objects to allocate.
+    template<typename T>
+    class ArenaAllocator {
+    private:
+        MonotonicArena* arena;
+
+        template<typename U> friend class ArenaAllocator;
+
+    public:
+        using value_type = T;
+
+        /// @brief Allocates from the calling thread's default arena.
+        ArenaAllocator() : arena(&MonotonicArena::thread_local_arena()) {}
+
+        /// @brief Allocates from the given arena.
+        explicit ArenaAllocator(MonotonicArena& source) : arena(&source) {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+        T* allocate(size_t n) {
+            return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        /// @brief A no-op; the memory is reclaimed when the arena is released.
+        void deallocate(T*, size_t) {}
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+        template<typename U>
+        bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+    };
+} // namespace container
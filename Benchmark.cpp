@@ -0,0 +1,925 @@
+//Benchmark.cpp
+// meirshuker15@gmail.com
+//Description: Micro-benchmarks for the MyContainer class.
+//Run every benchmark with `make bench`, or pass benchmark names to ./bench_run to pick some.
+//Options: --min-n=N and --max-n=N bound the sweep (default 10 .. 10^6), --csv=FILE and
+//--json=FILE save the results, --baseline=FILE compares them with an earlier CSV and --quiet
+//prints only that comparison.
+#include "MyContainer.hpp"
+#include "ArenaAllocator.hpp"
+#include "ConcurrentMyContainer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace container;
+
+/// @brief A Person-like payload for the sweep: a heap-allocated name and a small sort key.
+struct BenchPerson {
+    std::string name;
+    int age;
+
+    bool operator==(const BenchPerson& other) const { return name == other.name && age == other.age; }
+    bool operator<(const BenchPerson& other) const { return age < other.age; }
+};
+
+namespace container {
+    template<>
+    struct index_snapshot<BenchPerson> : std::true_type {};
+}
+
+namespace {
+
+    /// @brief A named benchmark entry point.
+    struct Benchmark {
+        const char* name;
+        void (*run)();
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Seconds elapsed since the given start time.
+    double seconds_since(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    /// @brief One measurement, kept for the CSV and JSON reports.
+    struct Result {
+        std::string name;
+        size_t n;
+        double seconds;
+        std::string detail;
+    };
+
+    /// @brief Every result reported so far, in order.
+    std::vector<Result> results;
+
+    /// @brief Set by --quiet: collect results without printing them.
+    bool quiet = false;
+
+    /// @brief Prints one result line, with an optional free-form detail.
+    void report(const std::string& name, size_t n, double seconds, const std::string& detail = "") {
+        results.push_back({name, n, seconds, detail});
+        if (quiet) return;
+        std::cout << std::left << std::setw(40) << name
+                  << " n=" << std::setw(10) << n
+                  << std::right << std::fixed << std::setprecision(3) << std::setw(10)
+                  << seconds * 1000.0 << " ms";
+        if (!detail.empty()) {
+            std::cout << "  " << detail;
+        }
+        std::cout << std::endl;
+    }
+
+    /// @brief Quotes a field for CSV or JSON output (only quotes and backslashes need escaping).
+    std::string quoted(const std::string& text, bool json) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"') {
+                out += json ? "\\\"" : "\"\"";
+            } else if (c == '\\' && json) {
+                out += "\\\\";
+            } else {
+                out += c;
+            }
+        }
+        return out + "\"";
+    }
+
+    /// @brief Writes every result as CSV: name, n, seconds, ns per element, detail.
+    void write_csv(const std::string& path) {
+        std::ofstream out(path);
+        out << "name,n,seconds,ns_per_element,detail\n" << std::setprecision(9);
+        for (const Result& r : results) {
+            out << quoted(r.name, false) << ',' << r.n << ',' << r.seconds << ','
+                << (r.n ? r.seconds * 1e9 / r.n : 0.0) << ',' << quoted(r.detail, false) << '\n';
+        }
+    }
+
+    /// @brief Writes every result as a JSON array of objects with the CSV's fields.
+    void write_json(const std::string& path) {
+        std::ofstream out(path);
+        out << "[\n" << std::setprecision(9);
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            out << "  {\"name\": " << quoted(r.name, true) << ", \"n\": " << r.n
+                << ", \"seconds\": " << r.seconds
+                << ", \"ns_per_element\": " << (r.n ? r.seconds * 1e9 / r.n : 0.0)
+                << ", \"detail\": " << quoted(r.detail, true) << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+
+    /// @brief Prints each result next to the same name and n from an earlier CSV run.
+    /// @details Used by `make profiles` to compare optimisation profiles; a speedup above 1
+    ///          means this build is faster than the baseline.
+    void compare_with(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "cannot read baseline " << path << std::endl;
+            return;
+        }
+        std::map<std::pair<std::string, size_t>, double> baseline;
+        std::string line;
+        std::getline(in, line); // header
+        while (std::getline(in, line)) {
+            // Names never contain commas, so the quoted name ends at the first '",'
+            size_t name_end = line.find("\",");
+            if (line.empty() || line[0] != '"' || name_end == std::string::npos) continue;
+            std::istringstream fields(line.substr(name_end + 2));
+            size_t n = 0;
+            double seconds = 0;
+            char comma = 0;
+            if (fields >> n >> comma >> seconds) {
+                baseline[std::make_pair(line.substr(1, name_end - 1), n)] = seconds;
+            }
+        }
+
+        std::cout << std::left << std::setw(40) << "benchmark" << " n=" << std::setw(10) << "n"
+                  << std::right << std::setw(13) << "baseline ms" << std::setw(13) << "this ms"
+                  << std::setw(10) << "speedup" << std::endl;
+        for (const Result& r : results) {
+            auto found = baseline.find(std::make_pair(r.name, r.n));
+            if (found == baseline.end()) continue;
+            std::cout << std::left << std::setw(40) << r.name << " n=" << std::setw(10) << r.n
+                      << std::right << std::fixed << std::setprecision(3)
+                      << std::setw(13) << found->second * 1000.0 << std::setw(13) << r.seconds * 1000.0
+                      << std::setw(9) << std::setprecision(2)
+                      << (r.seconds > 0 ? found->second / r.seconds : 0.0) << "x" << std::endl;
+        }
+    }
+
+    /// @brief Deterministic pseudo-random values, so every run measures the same input.
+    std::vector<int> random_ints(size_t n, unsigned seed = 12345) {
+        std::vector<int> values(n);
+        unsigned state = seed;
+        for (size_t i = 0; i < n; ++i) {
+            state = state * 1103515245u + 12345u;
+            values[i] = static_cast<int>(state >> 1);
+        }
+        return values;
+    }
+
+    /// @brief Keeps the optimizer from discarding a computed value.
+    volatile long long sink = 0;
+
+    /*===============================================
+    Remove
+    ===============================================*/
+
+    /// @brief Removes many distinct values from a large container, linear scan vs hash index.
+    void bench_remove() {
+        const size_t n = 1000000;
+        const size_t removals = 1000;
+        std::vector<int> values = random_ints(n);
+
+        for (int indexed = 0; indexed < 2; ++indexed) {
+            MyContainer<int> container;
+            for (int v : values) {
+                container.add(v);
+            }
+            if (indexed) {
+                container.enable_hash_index();
+            }
+
+            Clock::time_point start = Clock::now();
+            for (size_t i = 0; i < removals; ++i) {
+                container.remove(values[i * (n / removals)]);
+            }
+            double removing = seconds_since(start);
+            // The hash index defers compaction to the first read
+            sink = sink + *container.begin_order();
+            double total = seconds_since(start);
+
+            if (indexed) {
+                report("remove x1000 (hash index)", n, removing);
+                report("remove x1000 + compaction (hash index)", n, total);
+            } else {
+                report("remove x1000 (linear scan)", n, total);
+            }
+        }
+    }
+
+    /// @brief Removes a batch of values (half of them misses), one call per value vs one pass.
+    void bench_erase_many() {
+        const size_t n = 1000000;
+        const size_t batch_size = 1000;
+        std::vector<int> values = random_ints(n);
+        std::vector<int> batch;
+        for (size_t i = 0; i < batch_size; ++i) {
+            batch.push_back(i % 2 == 0 ? values[i * (n / batch_size)] : -1 - static_cast<int>(i));
+        }
+
+        MyContainer<int> one_by_one;
+        MyContainer<int> batched;
+        for (int v : values) {
+            one_by_one.add(v);
+            batched.add(v);
+        }
+
+        Clock::time_point start = Clock::now();
+        size_t removed = 0;
+        for (int v : batch) {
+            removed += one_by_one.try_remove(v);
+        }
+        report("try_remove x1000", n, seconds_since(start));
+
+        start = Clock::now();
+        removed += batched.erase_many(batch);
+        report("erase_many(1000 values)", n, seconds_since(start));
+        sink = sink + static_cast<long long>(removed);
+    }
+
+    /*===============================================
+    Capacity
+    ===============================================*/
+
+    /// @brief Loads 10M elements with and without reserving, counting reallocations.
+    void bench_reserve() {
+        const size_t n = 10000000;
+
+        for (int reserved = 0; reserved < 2; ++reserved) {
+            Clock::time_point start = Clock::now();
+            MyContainer<int> container;
+            if (reserved) {
+                container.reserve(n);
+            }
+            size_t reallocations = 0;
+            size_t last_capacity = container.capacity();
+            for (size_t i = 0; i < n; ++i) {
+                container.add(static_cast<int>(i));
+                if (container.capacity() != last_capacity) {
+                    ++reallocations;
+                    last_capacity = container.capacity();
+                }
+            }
+            double elapsed = seconds_since(start);
+            report(reserved ? "load (reserve first)" : "load (no reserve)", n, elapsed,
+                   std::to_string(reallocations) + " reallocations");
+        }
+
+        Clock::time_point start = Clock::now();
+        MyContainer<int> container(n / 2);
+        std::vector<int> values = random_ints(n);
+        container.add_range(values.begin(), values.end());
+        container.remove_if([](int v) { return v % 2 == 0; });
+        container.shrink_to_fit();
+        report("add_range + remove half + shrink_to_fit", n, seconds_since(start),
+               "capacity " + std::to_string(container.capacity()));
+    }
+
+    /*===============================================
+    Allocators
+    ===============================================*/
+
+    /// @brief Builds a small container and walks its sorted orders once per simulated request.
+    template<typename Alloc>
+    double run_requests(size_t requests, size_t per_request, const Alloc& alloc, MonotonicArena* arena) {
+        std::vector<int> values = random_ints(per_request);
+        Clock::time_point start = Clock::now();
+        for (size_t r = 0; r < requests; ++r) {
+            {
+                MyContainer<int, Alloc> container(alloc);
+                container.add_range(values.begin(), values.end());
+                long long sum = 0;
+                for (auto it = container.begin_ascending_order(); it != container.end_sentinel(); ++it) {
+                    sum += *it;
+                }
+                for (auto it = container.begin_side_cross_order(); it != container.end_sentinel(); ++it) {
+                    sum += *it;
+                }
+                sink = sink + sum;
+            }
+            if (arena != nullptr) {
+                arena->reset();
+            }
+        }
+        return seconds_since(start);
+    }
+
+    /// @brief Short-lived containers and snapshots, global heap vs a monotonic arena.
+    void bench_arena() {
+        const size_t requests = 200000;
+        const size_t per_request = 64;
+        MonotonicArena arena;
+        report("64-element request (std::allocator)", requests,
+               run_requests(requests, per_request, std::allocator<int>(), nullptr));
+        report("64-element request (ArenaAllocator)", requests,
+               run_requests(requests, per_request, ArenaAllocator<int>(arena), &arena));
+    }
+
+    /// @brief Builds a tiny container and walks its sorted orders, heap vs inline storage.
+    template<typename Policy>
+    double run_tiny(size_t repetitions, const std::vector<int>& values) {
+        Clock::time_point start = Clock::now();
+        for (size_t r = 0; r < repetitions; ++r) {
+            MyContainer<int, Policy> container;
+            for (int v : values) {
+                container.add(v);
+            }
+            long long sum = 0;
+            for (auto it = container.begin_ascending_order(); it != container.end_sentinel(); ++it) {
+                sum += *it;
+            }
+            for (auto it = container.begin_middle_out_order(); it != container.end_sentinel(); ++it) {
+                sum += *it;
+            }
+            sink = sink + sum;
+        }
+        return seconds_since(start);
+    }
+
+    /// @brief The 5-element demo workload, std::vector storage vs InlineCapacity<16>.
+    void bench_inline() {
+        const size_t repetitions = 1000000;
+        std::vector<int> values = random_ints(5);
+        report("5-element container (std::allocator)", repetitions,
+               run_tiny<std::allocator<int>>(repetitions, values));
+        report("5-element container (InlineCapacity<16>)", repetitions,
+               run_tiny<InlineCapacity<16>>(repetitions, values));
+    }
+
+    /*===============================================
+    Sorting
+    ===============================================*/
+
+    /// @brief Times std::sort against the radix kernel on the same input.
+    template<typename T>
+    void compare_sorts(const std::string& type, const std::vector<T>& input) {
+        std::vector<T> a = input;
+        Clock::time_point start = Clock::now();
+        std::sort(a.begin(), a.end());
+        double comparison = seconds_since(start);
+
+        std::vector<T> b = input;
+        start = Clock::now();
+        radix_sort(b.data(), b.data() + b.size());
+        double radix = seconds_since(start);
+
+        sink = sink + static_cast<long long>(a[input.size() / 2] == b[input.size() / 2]);
+        report("std::sort<" + type + ">", input.size(), comparison);
+        report("radix_sort<" + type + ">", input.size(), radix,
+               std::to_string(comparison / radix).substr(0, 4) + "x");
+    }
+
+    /// @brief std::sort vs radix sort, directly and through the first ascending traversal.
+    void bench_radix() {
+        for (size_t n : {100000u, 1000000u, 10000000u}) {
+            std::vector<int> ints = random_ints(n);
+            std::vector<double> doubles(ints.begin(), ints.end());
+            for (double& d : doubles) {
+                d /= 1000.0;
+            }
+            compare_sorts("int", ints);
+            compare_sorts("double", doubles);
+        }
+
+        const size_t n = 10000000;
+        std::vector<int> values = random_ints(n);
+        MyContainer<int> container;
+        container.add_range(values.begin(), values.end());
+        Clock::time_point start = Clock::now();
+        sink = sink + *container.begin_ascending_order();
+        report("first begin_ascending_order() (radix)", n, seconds_since(start));
+    }
+
+    /// @brief Sorts many small arrays, std::sort vs the branchless sorting network.
+    template<typename T>
+    void compare_small_sorts(const std::string& type, size_t n) {
+        const size_t total = 4000000;
+        const size_t rounds = total / n;
+        std::vector<int> seeds = random_ints(total);
+        std::vector<T> input(seeds.begin(), seeds.end());
+        std::vector<T> work = input;
+
+        Clock::time_point start = Clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            std::sort(work.begin() + r * n, work.begin() + (r + 1) * n);
+        }
+        double comparison = seconds_since(start);
+
+        work = input;
+        start = Clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            network_sort(work.data() + r * n, work.data() + (r + 1) * n);
+        }
+        double network = seconds_since(start);
+
+        sink = sink + static_cast<long long>(work[n / 2]);
+        report("std::sort<" + type + "> x" + std::to_string(rounds), n, comparison);
+        report("network_sort<" + type + "> x" + std::to_string(rounds), n, network,
+               std::to_string(comparison / network).substr(0, 4) + "x");
+    }
+
+    /// @brief The small-range kernel used below radix_sort_threshold.
+    void bench_small_sort() {
+        for (size_t n : {8u, 16u, 64u, 255u}) {
+            compare_small_sorts<int32_t>("int32_t", n);
+            compare_small_sorts<int64_t>("int64_t", n);
+            compare_small_sorts<float>("float", n);
+            compare_small_sorts<double>("double", n);
+        }
+    }
+
+    /// @brief Rebuilds the sorted view of 10M ints and 2M strings at 1/2/4/8/16 threads.
+    void bench_parallel() {
+        std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+        const size_t n = 10000000;
+        std::vector<int> values = random_ints(n);
+        MyContainer<int> ints;
+        ints.add_range(values.begin(), values.end());
+
+        const size_t string_count = 2000000;
+        MyContainer<std::string> strings;
+        for (size_t i = 0; i < string_count; ++i) {
+            strings.add(std::to_string(values[i]));
+        }
+
+        double serial_ints = 0;
+        double serial_strings = 0;
+        for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+            ParallelPolicy policy(threads);
+            ints.add(0); // invalidate the cached view
+            Clock::time_point start = Clock::now();
+            sink = sink + *ints.begin_ascending_order(policy);
+            double elapsed = seconds_since(start);
+            serial_ints = threads == 1 ? elapsed : serial_ints;
+            report("parallel view<int> " + std::to_string(threads) + " threads", n, elapsed,
+                   std::to_string(serial_ints / elapsed).substr(0, 4) + "x");
+
+            strings.add("");
+            start = Clock::now();
+            sink = sink + static_cast<long long>(strings.begin_ascending_order(policy)->size());
+            elapsed = seconds_since(start);
+            serial_strings = threads == 1 ? elapsed : serial_strings;
+            report("parallel view<string> " + std::to_string(threads) + " threads", string_count, elapsed,
+                   std::to_string(serial_strings / elapsed).substr(0, 4) + "x");
+        }
+    }
+
+    /// @brief A per-element scoring pass over middle-out order at 1/2/4/8/16 threads.
+    void bench_for_each() {
+        const size_t n = 5000000;
+        std::vector<int> values = random_ints(n);
+        MyContainer<int> container;
+        container.add_range(values.begin(), values.end());
+        std::vector<double> scores(n);
+
+        double serial = 0;
+        for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+            Clock::time_point start = Clock::now();
+            container.parallel_for_each(orders::middle_out, [&scores](size_t position, const int& value) {
+                double score = value;
+                for (int round = 0; round < 16; ++round) {
+                    score = score * 0.5 + static_cast<double>(position % 97) / (round + 1);
+                }
+                scores[position] = score;
+            }, threads);
+            double elapsed = seconds_since(start);
+            serial = threads == 1 ? elapsed : serial;
+            sink = sink + static_cast<long long>(scores[n / 2]);
+            report("parallel_for_each " + std::to_string(threads) + " threads", n, elapsed,
+                   std::to_string(serial / elapsed).substr(0, 4) + "x");
+        }
+    }
+
+    /// @brief Reads the 10 smallest elements from a fresh view: full sort vs begin_ascending_order(k).
+    template<typename T>
+    void compare_first_k(const std::string& type, const std::vector<T>& values, size_t k) {
+        MyContainer<T> container;
+        container.add_range(values.begin(), values.end());
+
+        Clock::time_point start = Clock::now();
+        auto full = container.begin_ascending_order();
+        sink = sink + static_cast<long long>(full[k - 1] == full[0]);
+        double sorted = seconds_since(start);
+
+        container.add(values[0]); // invalidate the cached view
+        start = Clock::now();
+        auto partial = container.begin_ascending_order(k);
+        sink = sink + static_cast<long long>(partial[k - 1] == partial[0]);
+        double selected = seconds_since(start);
+
+        report("first " + std::to_string(k) + " of " + type + " (full sort)", values.size(), sorted);
+        report("first " + std::to_string(k) + " of " + type + " (partial)", values.size(), selected,
+               std::to_string(sorted / selected).substr(0, 4) + "x");
+    }
+
+    /// @brief Top-k selection against the full sorted view.
+    void bench_top_k() {
+        std::vector<int> ints = random_ints(10000000);
+        compare_first_k("int", ints, 10);
+        compare_first_k("int", ints, 100);
+        std::vector<std::string> strings;
+        for (size_t i = 0; i < 1000000; ++i) {
+            strings.push_back(std::to_string(ints[i]));
+        }
+        compare_first_k("string", strings, 10);
+        compare_first_k("string", strings, 100);
+    }
+
+    /// @brief Reads the 5 smallest elements after every change: sorted view vs lazy heap.
+    template<typename T>
+    void compare_lazy(const std::string& type, const std::vector<T>& values) {
+        const size_t queries = 5;
+        MyContainer<T> container;
+        container.add_range(values.begin(), values.end());
+
+        Clock::time_point start = Clock::now();
+        for (size_t q = 0; q < queries; ++q) {
+            container.add(values[q]); // a new pending job invalidates the view
+            auto it = container.begin_ascending_order();
+            sink = sink + static_cast<long long>(it[4] == it[0]);
+        }
+        double sorted = seconds_since(start);
+
+        start = Clock::now();
+        for (size_t q = 0; q < queries; ++q) {
+            container.add(values[q]);
+            auto it = container.begin_lazy_ascending_order();
+            for (int k = 0; k < 4; ++k) {
+                ++it;
+            }
+            sink = sink + static_cast<long long>(*it == *it);
+        }
+        double lazy = seconds_since(start);
+
+        report("5 x (add + 5 smallest) " + type + " (sorted view)", values.size(), sorted);
+        report("5 x (add + 5 smallest) " + type + " (lazy heap)", values.size(), lazy,
+               std::to_string(sorted / lazy).substr(0, 4) + "x");
+    }
+
+    /// @brief Time to the first few elements of a freshly changed container.
+    void bench_lazy() {
+        std::vector<int> ints = random_ints(10000000);
+        compare_lazy("int", ints);
+        std::vector<std::string> strings;
+        for (size_t i = 0; i < 1000000; ++i) {
+            strings.push_back(std::to_string(ints[i]));
+        }
+        compare_lazy("string", strings);
+    }
+
+    /// @brief The first 10 elements through a view pipeline against the hand-written loop.
+    template<typename T>
+    void compare_views(const std::string& type, const std::vector<T>& values) {
+        const size_t k = 10;
+        MyContainer<T> container;
+        container.add_range(values.begin(), values.end());
+
+        Clock::time_point start = Clock::now();
+        size_t seen = 0;
+        for (auto it = container.begin_ascending_order(); it != container.end_ascending_order() && seen < k; ++it, ++seen) {
+            sink = sink + static_cast<long long>(*it == *it);
+        }
+        double loop = seconds_since(start);
+
+        container.add(values[0]); // a stale view again
+        start = Clock::now();
+        for (const T& value : container.ascending() | views::take(k)) {
+            sink = sink + static_cast<long long>(value == value);
+        }
+        double view = seconds_since(start);
+
+        report("first 10 of " + type + " (loop)", values.size(), loop);
+        report("first 10 of " + type + " (ascending | take)", values.size(), view,
+               std::to_string(loop / view).substr(0, 4) + "x");
+    }
+
+    /// @brief Order views: partial sorting through take, and the cost of a full pipeline scan.
+    void bench_views() {
+        std::vector<int> ints = random_ints(10000000);
+        compare_views("int", ints);
+        std::vector<std::string> strings;
+        for (size_t i = 0; i < 1000000; ++i) {
+            strings.push_back(std::to_string(ints[i]));
+        }
+        compare_views("string", strings);
+
+        MyContainer<int> container;
+        container.add_range(ints.begin(), ints.end());
+        container.begin_ascending_order(); // both scans read the cached view
+        Clock::time_point start = Clock::now();
+        long long sum = 0;
+        for (auto it = container.begin_ascending_order(); it != container.end_sentinel(); ++it) {
+            if (*it % 2 == 0) sum += *it / 2;
+        }
+        double loop = seconds_since(start);
+        start = Clock::now();
+        for (int half : container.ascending() | views::filter([](int v) { return v % 2 == 0; })
+                                              | views::transform([](int v) { return v / 2; })) {
+            sum += half;
+        }
+        double view = seconds_since(start);
+        sink = sink + sum;
+        report("scan int (loop)", ints.size(), loop);
+        report("scan int (ascending | filter | transform)", ints.size(), view,
+               std::to_string(loop / view).substr(0, 4) + "x");
+    }
+
+    /*===============================================
+    Concurrent Readers
+    ===============================================*/
+
+    /// @brief Runs reader threads that scan while the calling thread writes a batch every
+    ///        millisecond, for one second, and reports the scan and batch rates.
+    template<typename Read, typename Write>
+    void readers_and_writer(const std::string& name, size_t n, unsigned readers, Read read, Write write) {
+        std::atomic<bool> done(false);
+        std::atomic<size_t> scans(0);
+        size_t batches = 0;
+        Clock::time_point start = Clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned r = 0; r < readers; ++r) {
+            threads.emplace_back([&done, &scans, &read]() {
+                while (!done) {
+                    read();
+                    ++scans;
+                }
+            });
+        }
+        while (seconds_since(start) < 1.0) {
+            write();
+            ++batches;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        done = true;
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        double elapsed = seconds_since(start);
+        size_t total = std::max<size_t>(1, scans);
+        report(name + " " + std::to_string(readers) + " readers", n, elapsed / total,
+               std::to_string(static_cast<size_t>(total / elapsed)) + " scans/s, " +
+               std::to_string(static_cast<size_t>(batches / elapsed)) + " batches/s");
+    }
+
+    /// @brief Times one small batch at a time on an n-element ConcurrentMyContainer, i.e. the
+    ///        cost of publishing a snapshot, with and without a hash index on the working copy.
+    void publish_cost(size_t n, bool indexed) {
+        std::vector<int> values = random_ints(n + 1000);
+        ConcurrentMyContainer<int> shared;
+        shared.update([&](MyContainer<int>& c) {
+            if (indexed) c.enable_hash_index();
+            c.add_range(values.begin(), values.begin() + n);
+        });
+        const size_t rounds = 20;
+        Clock::time_point start = Clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            shared.update([&](MyContainer<int>& c) {
+                c.add(values[n + r]);
+                c.try_remove(values[r]);
+            });
+        }
+        report(std::string("publish one batch") + (indexed ? " (hash index)" : ""), n, seconds_since(start) / rounds);
+    }
+
+    /// @brief Readers scanning the ascending order while one writer ingests batches: a
+    ///        MyContainer behind a global mutex against ConcurrentMyContainer snapshots.
+    void bench_concurrent() {
+        publish_cost(1000000, false);
+        publish_cost(1000000, true);
+        std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+        const size_t n = 100000;
+        const size_t batch = 100;
+        std::vector<int> values = random_ints(n + 100000);
+
+        for (unsigned readers : {1u, 4u, 8u}) {
+            std::mutex mutex;
+            MyContainer<int> locked;
+            locked.add_range(values.begin(), values.begin() + n);
+            size_t next = n;
+            readers_and_writer("mutex", n, readers, [&mutex, &locked]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                long long sum = 0;
+                for (auto it = locked.begin_ascending_order(); it != locked.end_sentinel(); ++it) {
+                    sum += *it;
+                }
+                sink = sink + sum;
+            }, [&]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                locked.add_range(values.begin() + next, values.begin() + next + batch);
+                locked.erase_many(values.begin() + next - n, values.begin() + next - n + batch);
+                next = next + batch < values.size() ? next + batch : n;
+            });
+
+            ConcurrentMyContainer<int> shared;
+            shared.add_range(values.begin(), values.begin() + n);
+            next = n;
+            readers_and_writer("snapshots", n, readers, [&shared]() {
+                auto snap = shared.snapshot();
+                long long sum = 0;
+                for (auto it = snap->begin_ascending_order(); it != snap->end_sentinel(); ++it) {
+                    sum += *it;
+                }
+                sink = sink + sum;
+            }, [&]() {
+                shared.update([&](MyContainer<int>& c) {
+                    c.add_range(values.begin() + next, values.begin() + next + batch);
+                    c.erase_many(values.begin() + next - n, values.begin() + next - n + batch);
+                });
+                next = next + batch < values.size() ? next + batch : n;
+            });
+        }
+    }
+
+    /*===============================================
+    Sweep
+    ===============================================*/
+
+    /// @brief The smallest and largest n of the sweep, set with --min-n and --max-n.
+    size_t sweep_min_n = 10;
+    size_t sweep_max_n = 1000000;
+
+    void make_value(int seed, int& out) { out = seed; }
+    void make_value(int seed, double& out) { out = seed / 1000.0; }
+    void make_value(int seed, std::string& out) { out = std::to_string(seed); }
+    void make_value(int seed, BenchPerson& out) {
+        out.name = "person-" + std::to_string(seed);
+        out.age = seed % 100;
+    }
+
+    /// @brief Formats a per-item cost, e.g. "12.5 ns/add".
+    std::string per_item(double seconds, size_t items, const std::string& unit) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1) << seconds * 1e9 / items << " " << unit;
+        return out.str();
+    }
+
+    /// @brief Walks [first, last), reading every element, and returns the elapsed seconds.
+    template<typename It, typename End>
+    double time_scan(It first, End last) {
+        Clock::time_point start = Clock::now();
+        size_t checksum = 0;
+        for (; first != last; ++first) {
+            checksum += reinterpret_cast<size_t>(&*first);
+        }
+        sink = sink + static_cast<long long>(checksum);
+        return seconds_since(start);
+    }
+
+    /// @brief Measures add, remove, and begin/end plus a full scan of each order, for n = 10 .. max.
+    /// @details Small n are repeated on fresh containers (about 10^6 elements per step) and
+    ///          averaged. begin/end of the ascending order includes building the shared sorted
+    ///          view; descending and side-cross then reuse it.
+    template<typename T>
+    void sweep_type(const std::string& type) {
+        const char* orders[] = {"order", "reverse", "ascending", "descending", "side_cross", "middle_out"};
+        for (size_t n = 10; n <= sweep_max_n; n *= 10) {
+            if (n < sweep_min_n) continue;
+            std::vector<int> seeds = random_ints(n);
+            std::vector<T> values(n);
+            for (size_t i = 0; i < n; ++i) {
+                make_value(seeds[i], values[i]);
+            }
+            const size_t reps = std::max<size_t>(1, 1000000 / n);
+            // Each remove is a linear scan, so keep about 10^7 element visits per step
+            const size_t removals = std::max<size_t>(1, std::min<size_t>(n / 2, 10000000 / (n * reps)));
+            double adding = 0;
+            double removing = 0;
+            double begin_end[6] = {0, 0, 0, 0, 0, 0};
+            double scanning[6] = {0, 0, 0, 0, 0, 0};
+
+            for (size_t r = 0; r < reps; ++r) {
+                MyContainer<T> container;
+                Clock::time_point start = Clock::now();
+                for (const T& v : values) {
+                    container.add(v);
+                }
+                adding += seconds_since(start);
+
+                start = Clock::now();
+                for (size_t i = 0; i < removals; ++i) {
+                    container.try_remove(values[i * (n / removals)]);
+                }
+                removing += seconds_since(start);
+
+                start = Clock::now();
+                auto order_first = container.begin_order();
+                auto order_last = container.end_order();
+                begin_end[0] += seconds_since(start);
+                start = Clock::now();
+                auto reverse_first = container.begin_reverse_order();
+                auto reverse_last = container.end_reverse_order();
+                begin_end[1] += seconds_since(start);
+                start = Clock::now();
+                auto ascending_first = container.begin_ascending_order();
+                auto ascending_last = container.end_ascending_order();
+                begin_end[2] += seconds_since(start);
+                start = Clock::now();
+                auto descending_first = container.begin_descending_order();
+                auto descending_last = container.end_descending_order();
+                begin_end[3] += seconds_since(start);
+                start = Clock::now();
+                auto cross_first = container.begin_side_cross_order();
+                auto cross_last = container.end_side_cross_order();
+                begin_end[4] += seconds_since(start);
+                start = Clock::now();
+                auto middle_first = container.begin_middle_out_order();
+                auto middle_last = container.end_middle_out_order();
+                begin_end[5] += seconds_since(start);
+
+                scanning[0] += time_scan(order_first, order_last);
+                scanning[1] += time_scan(reverse_first, reverse_last);
+                scanning[2] += time_scan(ascending_first, ascending_last);
+                scanning[3] += time_scan(descending_first, descending_last);
+                scanning[4] += time_scan(cross_first, cross_last);
+                scanning[5] += time_scan(middle_first, middle_last);
+            }
+
+            const std::string prefix = "sweep/" + type + "/";
+            report(prefix + "add", n, adding / reps, per_item(adding / reps, n, "ns/add"));
+            report(prefix + "remove", n, removing / reps, per_item(removing / reps, removals, "ns/remove"));
+            for (int o = 0; o < 6; ++o) {
+                report(prefix + "begin+end/" + orders[o], n, begin_end[o] / reps,
+                       per_item(begin_end[o] / reps, n, "ns/element"));
+            }
+            for (int o = 0; o < 6; ++o) {
+                report(prefix + "scan/" + orders[o], n, scanning[o] / reps,
+                       per_item(scanning[o] / reps, n, "ns/element"));
+            }
+        }
+    }
+
+    /// @brief The cost of every basic operation across sizes and element types.
+    void bench_sweep() {
+        sweep_type<int>("int");
+        sweep_type<double>("double");
+        sweep_type<std::string>("string");
+        sweep_type<BenchPerson>("person");
+    }
+
+    const Benchmark benchmarks[] = {
+        {"remove", bench_remove},
+        {"erase_many", bench_erase_many},
+        {"reserve", bench_reserve},
+        {"arena", bench_arena},
+        {"inline", bench_inline},
+        {"radix", bench_radix},
+        {"small_sort", bench_small_sort},
+        {"parallel", bench_parallel},
+        {"for_each", bench_for_each},
+        {"top_k", bench_top_k},
+        {"lazy", bench_lazy},
+        {"views", bench_views},
+        {"concurrent", bench_concurrent},
+        {"sweep", bench_sweep},
+    };
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> selected_names;
+    std::string csv_path;
+    std::string json_path;
+    std::string baseline_path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 8, "--min-n=") == 0) {
+            sweep_min_n = static_cast<size_t>(std::strtod(arg.c_str() + 8, nullptr));
+        } else if (arg.compare(0, 8, "--max-n=") == 0) {
+            sweep_max_n = static_cast<size_t>(std::strtod(arg.c_str() + 8, nullptr));
+        } else if (arg.compare(0, 11, "--baseline=") == 0) {
+            baseline_path = arg.substr(11);
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else if (arg.compare(0, 6, "--csv=") == 0) {
+            csv_path = arg.substr(6);
+        } else if (arg.compare(0, 7, "--json=") == 0) {
+            json_path = arg.substr(7);
+        } else {
+            selected_names.push_back(arg);
+        }
+    }
+
+    for (const Benchmark& benchmark : benchmarks) {
+        bool selected = selected_names.empty();
+        for (const std::string& name : selected_names) {
+            if (name == benchmark.name) selected = true;
+        }
+        if (selected) {
+            benchmark.run();
+        }
+    }
+
+    if (!csv_path.empty()) {
+        write_csv(csv_path);
+    }
+    if (!json_path.empty()) {
+        write_json(json_path);
+    }
+    if (!baseline_path.empty()) {
+        compare_with(baseline_path);
+    }
+    return 0;
+}
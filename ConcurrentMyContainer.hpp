@@ -0,0 +1,170 @@
+// meirshuker15@gmail.com
+//ConcurrentMyContainer.hpp
+//Description: A MyContainer shared between reader threads and writer threads through
+//immutable, RCU-style snapshots. Readers take the current snapshot and iterate any order
+//without locks; writers apply batches to a private copy and publish a new snapshot.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "MyContainer.hpp"
+
+namespace container {
+
+    template<typename T> class ArenaAllocator;
+
+    /// @brief Whether reader threads may allocate through copies of Alloc at the same time.
+    /// @details Readers of a snapshot allocate through its allocator for the lazy order's heap
+    ///          and for top-k views. ArenaAllocator<T> bumps an unsynchronised arena, so it is
+    ///          rejected. A std::pmr::polymorphic_allocator is accepted, but its resource must
+    ///          be thread-safe, e.g. std::pmr::synchronized_pool_resource or the default
+    ///          new_delete_resource(), not an unsynchronized_pool_resource or monotonic buffer.
+    template<typename Alloc>
+    struct concurrent_allocator : std::true_type {};
+
+    template<typename T>
+    struct concurrent_allocator<ArenaAllocator<T>> : std::false_type {};
+
+    /// @brief A thread-safe MyContainer with lock-free reads through published snapshots.
+    /// @details Writers serialise on a mutex and change a private working container, which
+    ///          keeps its sorted view up to date through maintain_sorted_index(). Each update
+    ///          then publishes a snapshot_copy() of it: one copy of the element buffer that
+    ///          shares the current sorted view and leaves the hash index behind, so publishing
+    ///          never sorts and costs O(n) whatever the working container indexes. A published
+    ///          snapshot is never modified again, and since it has nothing left to build
+    ///          lazily, any number of threads may iterate, slice or take views of it at once.
+    ///          Each update still copies the elements once, so group changes with update()
+    ///          rather than publishing after every add().
+    /// @tparam T The type of elements to be stored in the container.
+    /// @tparam Alloc As for MyContainer: an allocator or InlineCapacity<N>; see
+    ///         concurrent_allocator for the allocators readers may share.
+    template<typename T, typename Alloc = std::allocator<T>>
+    class ConcurrentMyContainer {
+        static_assert(concurrent_allocator<Alloc>::value,
+                      "ConcurrentMyContainer readers allocate concurrently; ArenaAllocator is not thread-safe");
+
+    public:
+        using container_type = MyContainer<T, Alloc>;
+        /// @brief A published, immutable state of the container.
+        /// @note Iterators into a snapshot are valid while the snapshot is held.
+        using snapshot_type = std::shared_ptr<const container_type>;
+
+    private:
+        /// @brief The writers' copy of the elements; guarded by writer_mutex.
+        container_type working;
+        std::mutex writer_mutex;
+
+        /// @brief The latest snapshot, swapped atomically so readers never take the mutex.
+#if defined(__cpp_lib_atomic_shared_ptr)
+        std::atomic<snapshot_type> current;
+
+        snapshot_type load() const { return current.load(std::memory_order_acquire); }
+        void store(snapshot_type next) { current.store(std::move(next), std::memory_order_release); }
+#else
+        snapshot_type current;
+
+        snapshot_type load() const { return std::atomic_load_explicit(&current, std::memory_order_acquire); }
+        void store(snapshot_type next) { std::atomic_store_explicit(&current, std::move(next), std::memory_order_release); }
+#endif
+
+        /// @brief Publishes a reader's copy of the working container.
+        /// @details The copy shares the sorted view, built here only if a batch turned
+        ///          maintain_sorted_index() off, and has no lazily built state left.
+        void publish() {
+            store(std::make_shared<const container_type>(working.snapshot_copy()));
+        }
+
+        /// @brief Resets the working elements to the published snapshot after a failed batch.
+        /// @details Replaces them through remove_if() and add_range(), so a hash index and a
+        ///          maintained sorted view follow along. Settings that fn changed, such as
+        ///          enable_hash_index(), are kept.
+        void roll_back() {
+            snapshot_type published = load();
+            working.remove_if([](const T&) { return true; });
+            working.add_range(published->begin_order(), published->end_order());
+        }
+
+    public:
+        /// @brief Constructs an empty container with an empty published snapshot.
+        ConcurrentMyContainer() {
+            working.maintain_sorted_index();
+            publish();
+        }
+
+        /// @brief Constructs a container that starts from a copy of the given elements.
+        explicit ConcurrentMyContainer(container_type initial) : working(std::move(initial)) {
+            working.maintain_sorted_index();
+            publish();
+        }
+
+        ConcurrentMyContainer(const ConcurrentMyContainer&) = delete;
+        ConcurrentMyContainer& operator=(const ConcurrentMyContainer&) = delete;
+
+        /// @brief Gets the current snapshot; never blocks on writers.
+        /// @details Usage: auto snap = c.snapshot(); for (const T& v : snap->ascending()) { ... }
+        snapshot_type snapshot() const { return load(); }
+
+        /// @brief Gets the number of elements in the current snapshot.
+        int size() const { return load()->size(); }
+
+        /// @brief Applies a batch of changes and publishes them as one snapshot.
+        /// @details fn(container_type&) runs under the writer mutex and may call any MyContainer
+        ///          member, e.g. add_range(), erase_many(), maintain_sorted_index() or
+        ///          enable_hash_index(). Readers keep seeing the previous snapshot until fn
+        ///          returns. If fn throws, nothing is published and the working elements are
+        ///          rolled back to the current snapshot before the exception propagates.
+        /// @param fn The batch of changes.
+        template<typename Fn>
+        void update(Fn fn) {
+            std::lock_guard<std::mutex> lock(writer_mutex);
+            try {
+                fn(working);
+            } catch (...) {
+                roll_back();
+                throw;
+            }
+            publish();
+        }
+
+        /// @brief Adds one element and publishes; prefer update() or add_range() for many.
+        void add(const T& element) {
+            update([&element](container_type& c) { c.add(element); });
+        }
+
+        /// @brief Adds every element of a range and publishes once.
+        template<typename InputIt>
+        void add_range(InputIt first, InputIt last) {
+            update([&first, &last](container_type& c) { c.add_range(first, last); });
+        }
+
+        /// @brief Removes all occurrences of an element and publishes.
+        /// @return The number of occurrences removed, 0 if the element was not found.
+        size_t try_remove(const T& element) {
+            size_t removed = 0;
+            update([&element, &removed](container_type& c) { removed = c.try_remove(element); });
+            return removed;
+        }
+
+        /// @brief Removes all occurrences of an element and publishes.
+        /// @throws std::invalid_argument if the specified element is not found in the container.
+        void remove(const T& element) {
+            if (try_remove(element) == 0) {
+                throw std::invalid_argument("Element not found in container.");
+            }
+        }
+
+        /// @brief Removes all occurrences of every value in a range and publishes once.
+        /// @return The number of elements removed.
+        template<typename InputIt>
+        size_t erase_many(InputIt first, InputIt last) {
+            size_t removed = 0;
+            update([&first, &last, &removed](container_type& c) { removed = c.erase_many(first, last); });
+            return removed;
+        }
+    };
+} // namespace container
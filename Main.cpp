@@ -32,25 +32,25 @@ int main() {
     std::cout << std::endl;
 
     std::cout << "Ascending: ";
-    for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it) {
+    for (auto it = container.begin_ascending_order(); it != container.end_sentinel(); ++it) {
         std::cout << *it << ' ';   // 1 2 6 7 15
     }
     std::cout << std::endl;
 
     std::cout << "Descending: ";
-    for (auto it = container.begin_descending_order(); it != container.end_descending_order(); ++it) {
+    for (auto it = container.begin_descending_order(); it != container.end_sentinel(); ++it) {
         std::cout << *it << ' ';  // 15 7 6 2 1
     }
     std::cout << std::endl;
     
     std::cout << "Side-Cross: ";
-    for (auto it = container.begin_side_cross_order(); it != container.end_side_cross_order(); ++it) {
+    for (auto it = container.begin_side_cross_order(); it != container.end_sentinel(); ++it) {
         std::cout << *it << ' ';  // 1 15 2 7 6
     }
     std::cout << std::endl;
 
     std::cout << "Middle-Out: ";
-    for (auto it = container.begin_middle_out_order(); it != container.end_middle_out_order(); ++it) {
+    for (auto it = container.begin_middle_out_order(); it != container.end_sentinel(); ++it) {
         std::cout << *it << ' ';  // 6 15 1 7 2
     }
     std::cout << std::endl;
@@ -82,19 +82,19 @@ int main() {
     
     std::cout << "\n--- Iterators for String Container ---" << std::endl;
     std::cout << "Ascending: ";
-    for (auto it = string_container.begin_ascending_order(); it != string_container.end_ascending_order(); ++it) {
+    for (auto it = string_container.begin_ascending_order(); it != string_container.end_sentinel(); ++it) {
         std::cout << *it << ' ';
     }
     std::cout << std::endl;
 
     std::cout << "Descending: ";
-    for (auto it = string_container.begin_descending_order(); it != string_container.end_descending_order(); ++it) {
+    for (auto it = string_container.begin_descending_order(); it != string_container.end_sentinel(); ++it) {
         std::cout << *it << ' ';
     }
     std::cout << std::endl;
 
     std::cout << "Side-Cross: ";
-    for (auto it = string_container.begin_side_cross_order(); it != string_container.end_side_cross_order(); ++it) {
+    for (auto it = string_container.begin_side_cross_order(); it != string_container.end_sentinel(); ++it) {
         std::cout << *it << ' ';
     }
     std::cout << std::endl;
@@ -112,7 +112,7 @@ int main() {
     std::cout << std::endl;
 
     std::cout << "Middle-Out (strings): ";
-    for (auto it = string_container.begin_middle_out_order(); it != string_container.end_middle_out_order(); ++it) {
+    for (auto it = string_container.begin_middle_out_order(); it != string_container.end_sentinel(); ++it) {
         std::cout << *it << ' ';
     }
     std::cout << std::endl;
@@ -5,51 +5,976 @@
 
 #pragma once
 
+#include <cassert>
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <functional>
 #include <stdexcept>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <iterator>
+#include <initializer_list>
+#include "SmallVector.hpp"
+#include "RadixSort.hpp"
+#include "ParallelSort.hpp"
+#include "Views.hpp"
+
+// Newer standards light up faster paths; under C++11 and C++14 the fallbacks below are used
+#if __cplusplus >= 201703L
+#define CONTAINER_IF_CONSTEXPR if constexpr
+#if defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define CONTAINER_HAS_PMR 1
+#endif
+#endif
+#else
+#define CONTAINER_IF_CONSTEXPR if
+#endif
+
+#if __cplusplus >= 202002L && defined(__has_include)
+#if __has_include(<ranges>)
+#include <ranges>
+#define CONTAINER_HAS_RANGES 1
+#endif
+#endif
 
 namespace container {
+
+    /// @brief An empty end marker that the ordering iterators can be compared against.
+    /// @details Comparing an iterator with an EndSentinel only checks the iterator's own
+    ///          position against its snapshot size, so no end iterator has to be built.
+    ///          Under C++20 it is std::default_sentinel_t, so the iterators also compare
+    ///          against std::default_sentinel and model std::sentinel_for.
+#if defined(CONTAINER_HAS_RANGES)
+    using EndSentinel = std::default_sentinel_t;
+#else
+    struct EndSentinel {};
+#endif
+
+    /// @brief Tags naming the six traversal orders, for calls such as parallel_for_each().
+    struct InsertionOrderTag {};
+    struct ReverseOrderTag {};
+    struct AscendingOrderTag {};
+    struct DescendingOrderTag {};
+    struct SideCrossOrderTag {};
+    struct MiddleOutOrderTag {};
+
+    /// @brief Ready-made order tags, e.g. c.parallel_for_each(orders::middle_out, fn).
+    namespace orders {
+        const InsertionOrderTag insertion{};
+        const ReverseOrderTag reverse{};
+        const AscendingOrderTag ascending{};
+        const DescendingOrderTag descending{};
+        const SideCrossOrderTag side_cross{};
+        const MiddleOutOrderTag middle_out{};
+    } // namespace orders
+
+    /// @brief Selects how the sorted iterators snapshot a MyContainer<T>.
+    /// @details By default the sorted view is a copy of the values. Specialize this trait as
+    ///          std::true_type for heavy payloads (strings, user types) to sort a permutation
+    ///          of 32-bit positions instead, cutting the view from n*sizeof(T) to n*4 bytes.
+    ///          Index snapshots dereference through the container, so, like MiddleOutOrder,
+    ///          they are invalidated by add() and remove().
+    template<typename T>
+    struct index_snapshot : std::false_type {};
+
+    /// @brief Maps MyContainer's second template argument to its storage.
+    /// @details An allocator selects std::vector storage and shared snapshots; InlineCapacity<N>
+    ///          selects SmallVector storage and snapshots held inside the iterators.
+    template<typename T, typename Policy>
+    struct storage_traits {
+        static const size_t inline_capacity = 0;
+        using allocator_type = Policy;
+        template<typename U>
+        using buffer = std::vector<U, typename std::allocator_traits<Policy>::template rebind_alloc<U>>;
+    };
+
+    template<typename T, size_t N>
+    struct storage_traits<T, InlineCapacity<N>> {
+        static const size_t inline_capacity = N;
+        using allocator_type = std::allocator<T>;
+        template<typename U>
+        using buffer = SmallVector<U, N>;
+    };
     
     /// @brief A generic container class that stores a dynamic collection of elements.
     /// @details This container allows for adding and removing elements, and provides
     ///          six different types of iterators for traversing the elements in various orders.
+    /// @note Const traversal is not thread-safe on a stale container. The first sorted
+    ///       traversal after a change builds the cached sorted view, the first read after a
+    ///       hash-index removal compacts the elements, and a top-k query on a stale view caches
+    ///       its selection, all inside const members. Threads may read one container at once
+    ///       only after a single begin_ascending_order() call with no change since; with
+    ///       maintain_sorted_index() the view stays current across later add() and remove()
+    ///       calls, but those still need to be excluded from the reads. Readers that allocate,
+    ///       e.g. the lazy order and top-k views, also need a thread-safe allocator.
+    ///       ConcurrentMyContainer shares a container between readers and writers safely.
     /// @tparam T The type of elements to be stored in the container.
-    template<typename T>
+    /// @tparam Alloc The allocator for the elements; the sorted snapshots use it too (rebound),
+    ///         so e.g. ArenaAllocator<T> serves both from a monotonic arena. Passing
+    ///         InlineCapacity<N> instead keeps up to N elements and their snapshots inline.
+    template<typename T, typename Alloc = std::allocator<T>>
 
     class MyContainer {
     private:
+        using traits = storage_traits<T, Alloc>;
+
+    public:
+        using allocator_type = typename traits::allocator_type;
+        /// @brief The container used to store the elements.
+        using storage_type = typename traits::template buffer<T>;
+
+    private:
+        /// @brief Rebinds the container's allocator to another value type.
+        template<typename U>
+        using rebind_alloc = typename std::allocator_traits<allocator_type>::template rebind_alloc<U>;
+
+        /// @brief The buffer type for the positions of an index snapshot.
+        using position_buffer = typename traits::template buffer<uint32_t>;
+
         /// @brief The underlying std::vector used to store the container's elements.
-        std::vector<T> elements;
+        /// @details Mutable because removals made through the hash index are compacted lazily,
+        ///          on the first read that follows them.
+        mutable storage_type elements;
+
+        /// @brief Modification counter, bumped by every operation that changes the elements.
+        size_t version = 0;
+
+        /// @brief Counts the times the element buffer may have moved without a change of version.
+        /// @details Bumped by reserve() and shrink_to_fit(). Assigning a container bumps it too
+        ///          instead of copying it, since the assigned version can match the old one.
+        struct StorageEpoch {
+            size_t value = 0;
+
+            StorageEpoch() = default;
+            StorageEpoch(const StorageEpoch&) {}
+            StorageEpoch& operator=(const StorageEpoch&) {
+                ++value;
+                return *this;
+            }
+        };
+        StorageEpoch storage_epoch;
 
     public:
+        /// @brief An immutable ascending-sorted snapshot shared by the sorted iterators.
+        /// @details Holds either a sorted copy of the values or, when index_snapshot<T> is set,
+        ///          a sorted permutation of positions into the container's elements.
+        class SortedView {
+        public:
+            static const bool by_index = index_snapshot<T>::value;
+
+            /// @brief Sorted copy of the values (value snapshots only).
+            storage_type values;
+            /// @brief Positions into the elements in ascending order (index snapshots only).
+            /// @note 32 bits are enough since size() already reports the element count as an int.
+            position_buffer positions;
+
+            /// @brief Constructs an empty view whose buffers use the given allocator.
+            explicit SortedView(const allocator_type& alloc) : values(alloc), positions(rebind_alloc<uint32_t>(alloc)) {}
+
+            size_t size() const { return by_index ? positions.size() : values.size(); }
+            bool empty() const { return size() == 0; }
+
+            /// @brief Gets the k-th smallest element.
+            /// @param source The container's elements, used by index snapshots.
+            const T& at(size_t k, const storage_type& source) const {
+                CONTAINER_IF_CONSTEXPR (by_index) {
+                    return source[positions[k]];
+                } else {
+                    return values[k];
+                }
+            }
+        };
+
+        /// @brief Holds a small sorted view by value, so tiny containers never allocate for it.
+        /// @details Used with InlineCapacity<N>. Views larger than N are shared through a
+        ///          shared_ptr instead, so copying an iterator stays cheap once the storage spills.
+        class InlineViewHandle {
+        private:
+            SortedView local;
+            std::shared_ptr<const SortedView> shared;
+            bool engaged = false;
+        public:
+            InlineViewHandle() : local(allocator_type()) {}
+
+            explicit operator bool() const { return engaged; }
+            const SortedView* operator->() const { return shared ? shared.get() : &local; }
+            const SortedView& operator*() const { return *operator->(); }
+
+            void reset() {
+                local = SortedView(allocator_type());
+                shared.reset();
+                engaged = false;
+            }
+
+            /// @brief Stores a freshly built view.
+            void publish(SortedView&& view) {
+                if (view.size() <= traits::inline_capacity) {
+                    local = std::move(view);
+                    shared.reset();
+                } else {
+                    local = SortedView(allocator_type());
+                    shared = std::make_shared<SortedView>(std::move(view));
+                }
+                engaged = true;
+            }
+
+            /// @brief Gets the view for in-place maintenance; iterators hold their own copies
+            ///        of an inline view, and a shared one is copied first if still in use.
+            SortedView& writable() {
+                if (!shared) return local;
+                if (shared.use_count() > 1) {
+                    shared = std::make_shared<SortedView>(*shared);
+                }
+                return const_cast<SortedView&>(*shared);
+            }
+        };
+
+        /// @brief How iterators hold the sorted view: shared, or inline for InlineCapacity<N>.
+        using view_handle = typename std::conditional<traits::inline_capacity == 0,
+                                                      std::shared_ptr<const SortedView>,
+                                                      InlineViewHandle>::type;
+
+    private:
+        /// @brief Lazily built ascending-sorted view of the elements, shared by all sorted iterators.
+        /// @details The view is never modified once published, so iterators holding it keep
+        ///          their order even after the container changes. Rebuilding it from a const
+        ///          member is unsynchronised; see the class note on thread safety.
+        mutable view_handle sorted_cache;
+
+        /// @brief The value of version when sorted_cache was built.
+        mutable size_t sorted_version = 0;
+
+        /// @brief The last view of the k smallest or largest elements, built by partial_view().
+        mutable view_handle partial_cache;
+        mutable size_t partial_version = 0;
+        mutable size_t partial_k = 0;
+        mutable bool partial_largest = false;
+
+        static void publish(std::shared_ptr<const SortedView>& handle, SortedView&& view, const allocator_type& alloc) {
+            handle = std::allocate_shared<SortedView>(alloc, std::move(view));
+        }
+
+        static void publish(InlineViewHandle& handle, SortedView&& view, const allocator_type&) {
+            handle.publish(std::move(view));
+        }
+
+        static SortedView& writable(std::shared_ptr<const SortedView>& handle, const allocator_type& alloc) {
+            if (handle.use_count() > 1) {
+                handle = std::allocate_shared<SortedView>(alloc, *handle);
+            }
+            return const_cast<SortedView&>(*handle);
+        }
+
+        static SortedView& writable(InlineViewHandle& handle, const allocator_type&) {
+            return handle.writable();
+        }
+
+        /// @brief Returns the cached sorted view, rebuilding it only if the elements changed.
+        /// @param policy Sorts a rebuild on several threads when given.
+        const view_handle& sorted_view(const ParallelPolicy* policy = nullptr) const {
+            flush_removals();
+            if (!sorted_cache || sorted_version != version) {
+                SortedView fresh(elements.get_allocator());
+                CONTAINER_IF_CONSTEXPR (SortedView::by_index) {
+                    fresh.positions.resize(elements.size());
+                    for (size_t i = 0; i < elements.size(); ++i) {
+                        fresh.positions[i] = static_cast<uint32_t>(i);
+                    }
+                    const storage_type& source = elements;
+                    auto less = [&source](uint32_t a, uint32_t b) { return source[a] < source[b]; };
+                    if (policy != nullptr && !fresh.positions.empty()) {
+                        parallel_comparison_sort(fresh.positions.data(), fresh.positions.data() + fresh.positions.size(),
+                                                 less, *policy);
+                    } else {
+                        std::sort(fresh.positions.begin(), fresh.positions.end(), less);
+                    }
+                } else {
+                    fresh.values.assign(elements.begin(), elements.end());
+                    auto less = [](const T& a, const T& b) { return a < b; };
+                    if (policy != nullptr && !fresh.values.empty() && radix_sortable<T>::value) {
+                        parallel_sort(fresh.values.data(), fresh.values.data() + fresh.values.size(), less,
+                                      [](T* first, T* last) { sort_values(first, last); },
+                                      *policy);
+                    } else if (policy != nullptr && !fresh.values.empty()) {
+                        parallel_comparison_sort(fresh.values.data(), fresh.values.data() + fresh.values.size(),
+                                                 less, *policy);
+                    } else {
+                        sort_values(fresh.values.begin(), fresh.values.end());
+                    }
+                }
+                publish(sorted_cache, std::move(fresh), elements.get_allocator());
+                sorted_version = version;
+            }
+            return sorted_cache;
+        }
+
+        /// @brief Keeps the k items that come first under comp, in one pass with a bounded heap.
+        /// @details The heap's top is the worst item kept, so most items cost one comparison.
+        template<typename Buffer, typename Item, typename Compare>
+        static void heap_select(Buffer& out, size_t n, size_t k, Item item, Compare comp) {
+            if (k == 0) return;
+            for (size_t i = 0; i < n; ++i) {
+                if (out.size() < k) {
+                    out.push_back(item(i));
+                    std::push_heap(out.begin(), out.end(), comp);
+                } else if (comp(item(i), out.front())) {
+                    std::pop_heap(out.begin(), out.end(), comp);
+                    out.back() = item(i);
+                    std::push_heap(out.begin(), out.end(), comp);
+                }
+            }
+        }
+
+        /// @brief Builds a view of only the k smallest (or k largest) elements, in ascending order.
+        /// @details Small k keep a bounded heap over one pass, O(n log k) with no copy of the
+        ///          elements; larger k use std::nth_element, O(n). Either way only the k
+        ///          survivors are sorted. A current cached view is sliced in O(k) instead. The
+        ///          last selection is kept apart from the full view until the elements change,
+        ///          so begin_ascending_order(k) and end_ascending_order(k) share it. Slices are
+        ///          not kept, so a container with a current view is never written to here and
+        ///          threads may take partial views of a shared snapshot at once.
+        view_handle partial_view(size_t k, bool largest) const {
+            const storage_type& source = live();
+            const size_t n = source.size();
+            k = std::min(k, n);
+            if (partial_cache && partial_version == version && partial_k == k && partial_largest == largest) {
+                return partial_cache;
+            }
+            const size_t skip = largest ? n - k : 0; // first ascending rank that is kept
+            const bool use_heap = k <= n / 16;
+            SortedView part(elements.get_allocator());
+            if (sorted_view_current()) {
+                const SortedView& full = *sorted_cache;
+                if (SortedView::by_index) {
+                    part.positions.assign(full.positions.begin() + skip, full.positions.begin() + skip + k);
+                } else {
+                    part.values.assign(full.values.begin() + skip, full.values.begin() + skip + k);
+                }
+            } else if (SortedView::by_index) {
+                auto less = [&source](uint32_t a, uint32_t b) { return source[a] < source[b]; };
+                auto greater = [&source](uint32_t a, uint32_t b) { return source[b] < source[a]; };
+                if (use_heap) {
+                    auto position = [](size_t i) { return static_cast<uint32_t>(i); };
+                    if (largest) {
+                        heap_select(part.positions, n, k, position, greater);
+                    } else {
+                        heap_select(part.positions, n, k, position, less);
+                    }
+                } else {
+                    part.positions.resize(n);
+                    for (size_t i = 0; i < n; ++i) {
+                        part.positions[i] = static_cast<uint32_t>(i);
+                    }
+                    if (largest) {
+                        std::nth_element(part.positions.begin(), part.positions.begin() + skip, part.positions.end(), less);
+                        part.positions.erase(part.positions.begin(), part.positions.begin() + skip);
+                    } else {
+                        std::nth_element(part.positions.begin(), part.positions.begin() + k, part.positions.end(), less);
+                        part.positions.erase(part.positions.begin() + k, part.positions.end());
+                    }
+                }
+                std::sort(part.positions.begin(), part.positions.end(), less);
+            } else {
+                if (use_heap) {
+                    auto value = [&source](size_t i) -> const T& { return source[i]; };
+                    if (largest) {
+                        heap_select(part.values, n, k, value, [](const T& a, const T& b) { return b < a; });
+                    } else {
+                        heap_select(part.values, n, k, value, [](const T& a, const T& b) { return a < b; });
+                    }
+                } else {
+                    part.values.assign(source.begin(), source.end());
+                    if (largest) {
+                        std::nth_element(part.values.begin(), part.values.begin() + skip, part.values.end());
+                        part.values.erase(part.values.begin(), part.values.begin() + skip);
+                    } else {
+                        std::nth_element(part.values.begin(), part.values.begin() + k, part.values.end());
+                        part.values.erase(part.values.begin() + k, part.values.end());
+                    }
+                }
+                sort_values(part.values.begin(), part.values.end());
+            }
+            if (sorted_view_current()) {
+                view_handle slice;
+                publish(slice, std::move(part), elements.get_allocator());
+                return slice;
+            }
+            publish(partial_cache, std::move(part), elements.get_allocator());
+            partial_version = version;
+            partial_k = k;
+            partial_largest = largest;
+            return partial_cache;
+        }
+
+        /// @brief Whether add() and remove() update the sorted view instead of invalidating it.
+        bool maintain_sorted = false;
+
+        /// @brief Checks whether the sorted view is built and matches the current elements.
+        bool sorted_view_current() const {
+            return sorted_cache && sorted_version == version;
+        }
+
+        /// @brief Gets the sorted view for in-place maintenance.
+        /// @details Copies the view first if an iterator still shares it, so snapshots stay intact.
+        SortedView& writable_view() const {
+            return writable(sorted_cache, elements.get_allocator());
+        }
+
+        /// @brief Inserts the element at the given position into the sorted view by binary search.
+        void sorted_insert(size_t pos) {
+            SortedView& view = writable_view();
+            const T& value = elements[pos];
+            if (SortedView::by_index) {
+                const storage_type& source = elements;
+                auto at = std::upper_bound(view.positions.begin(), view.positions.end(), value,
+                                           [&source](const T& v, uint32_t p) { return v < source[p]; });
+                view.positions.insert(at, static_cast<uint32_t>(pos));
+            } else {
+                view.values.insert(std::upper_bound(view.values.begin(), view.values.end(), value), value);
+            }
+            sorted_version = version;
+        }
+
+        /// @brief Merges the elements appended from position first onwards into the sorted view.
+        void sorted_merge(size_t first) {
+            SortedView& view = writable_view();
+            if (SortedView::by_index) {
+                const storage_type& source = elements;
+                auto less = [&source](uint32_t a, uint32_t b) { return source[a] < source[b]; };
+                size_t mid = view.positions.size();
+                for (size_t i = first; i < elements.size(); ++i) {
+                    view.positions.push_back(static_cast<uint32_t>(i));
+                }
+                std::sort(view.positions.begin() + mid, view.positions.end(), less);
+                std::inplace_merge(view.positions.begin(), view.positions.begin() + mid, view.positions.end(), less);
+            } else {
+                size_t mid = view.values.size();
+                view.values.insert(view.values.end(), elements.begin() + first, elements.end());
+                sort_values(view.values.begin() + mid, view.values.end());
+                std::inplace_merge(view.values.begin(), view.values.begin() + mid, view.values.end());
+            }
+            sorted_version = version;
+        }
+
+        /// @brief Bookkeeping after elements were appended from position first onwards.
+        /// @param keep_view Whether the sorted view was current before the append.
+        void appended(size_t first, bool keep_view) {
+            if (first == elements.size()) return;
+            ++version;
+            if (position_index) {
+                for (size_t i = first; i < elements.size(); ++i) {
+                    position_index->insert(elements[i], i);
+                }
+            }
+            if (keep_view) {
+                if (elements.size() - first == 1) sorted_insert(first);
+                else sorted_merge(first);
+            }
+        }
+
+        /// @brief Reserves room for a forward range before appending it.
+        /// @details Grows at least geometrically so repeated small add_range() calls stay amortised O(1).
+        template<typename ForwardIt>
+        void reserve_for(ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+            size_t needed = elements.size() + static_cast<size_t>(std::distance(first, last));
+            if (needed > elements.capacity()) {
+                elements.reserve(std::max(needed, 2 * elements.capacity()));
+            }
+        }
+
+        /// @brief Single-pass input ranges cannot be measured up front.
+        template<typename InputIt>
+        void reserve_for(InputIt, InputIt, std::input_iterator_tag) {}
+
+        /// @brief Checks whether a range starts at one of the container's own elements, e.g.
+        ///        c.add_range(c.begin(), c.end()), whose iterators a reallocation would leave dangling.
+        template<typename InputIt>
+        bool starts_inside(InputIt first, InputIt last, std::true_type) const {
+            if (first == last || elements.size() == 0) return false;
+            const T* element = std::addressof(*first);
+            std::less<const T*> before;
+            return !before(element, &elements[0]) && before(element, &elements[0] + elements.size());
+        }
+
+        /// @brief Ranges that yield values or other types cannot refer to the elements.
+        template<typename InputIt>
+        bool starts_inside(InputIt, InputIt, std::false_type) const { return false; }
+
+        /// @brief Drops removed positions from an index snapshot.
+        /// @param positions The sorted view's positions.
+        /// @param removed The ascending positions of the removed elements.
+        /// @param shift Whether the elements were compacted, so the remaining positions move down
+        ///              past the removed slots before them.
+        static void drop_positions(position_buffer& positions, const std::vector<uint32_t>& removed, bool shift) {
+            size_t out = 0;
+            for (size_t i = 0; i < positions.size(); ++i) {
+                uint32_t p = positions[i];
+                auto below = std::lower_bound(removed.begin(), removed.end(), p);
+                if (below != removed.end() && *below == p) continue;
+                positions[out++] = shift ? p - static_cast<uint32_t>(below - removed.begin()) : p;
+            }
+            positions.resize(out);
+        }
+
+        /// @brief Erases every occurrence of a value from the sorted view.
+        /// @param element The removed value.
+        /// @param removed The ascending positions of the removed elements (index snapshots only).
+        /// @param shift Whether the elements have already been compacted.
+        void sorted_erase(const T& element, const std::vector<uint32_t>& removed, bool shift = true) {
+            SortedView& view = writable_view();
+            if (SortedView::by_index) {
+                drop_positions(view.positions, removed, shift);
+            } else {
+                auto range = std::equal_range(view.values.begin(), view.values.end(), element);
+                view.values.erase(std::remove(range.first, range.second, element), range.second);
+            }
+            sorted_version = version;
+        }
+
+        /// @brief Value-to-positions lookup used by remove() once a hash index is enabled.
+        class PositionIndex {
+        public:
+            virtual ~PositionIndex() {}
+            virtual PositionIndex* clone() const = 0;
+            /// @brief Records that the value is stored at the given position.
+            virtual void insert(const T& value, size_t pos) = 0;
+            /// @brief Removes the value's entries and returns their positions (empty if absent).
+            virtual std::vector<size_t> extract(const T& value) = 0;
+            /// @brief Moves every position down past the removed slots before it after a compaction.
+            /// @param removed The ascending positions that were compacted away.
+            virtual void shift(const std::vector<uint32_t>& removed) = 0;
+            virtual void clear() = 0;
+        };
+
+        /// @brief A PositionIndex backed by std::unordered_multimap, one node per element.
+        /// @tparam Hash The hash functor for T.
+        template<typename Hash>
+        class HashPositionIndex : public PositionIndex {
+        private:
+            std::unordered_multimap<T, size_t, Hash> positions;
+        public:
+            PositionIndex* clone() const override { return new HashPositionIndex(*this); }
+            void insert(const T& value, size_t pos) override { positions.emplace(value, pos); }
+            std::vector<size_t> extract(const T& value) override {
+                std::vector<size_t> found;
+                auto range = positions.equal_range(value);
+                for (auto it = range.first; it != range.second; ++it) {
+                    found.push_back(it->second);
+                }
+                positions.erase(range.first, range.second);
+                std::sort(found.begin(), found.end());
+                return found;
+            }
+            void shift(const std::vector<uint32_t>& removed) override {
+                for (auto& entry : positions) {
+                    entry.second -= std::lower_bound(removed.begin(), removed.end(), entry.second) - removed.begin();
+                }
+            }
+            void clear() override { positions.clear(); }
+        };
+
+        /// @brief Owning handle to the optional PositionIndex that deep-copies with the container.
+        class IndexHandle {
+        private:
+            std::unique_ptr<PositionIndex> index;
+        public:
+            IndexHandle() = default;
+            IndexHandle(const IndexHandle& other) : index(other.index ? other.index->clone() : nullptr) {}
+            IndexHandle(IndexHandle&&) = default;
+            IndexHandle& operator=(const IndexHandle& other) {
+                index.reset(other.index ? other.index->clone() : nullptr);
+                return *this;
+            }
+            IndexHandle& operator=(IndexHandle&&) = default;
+
+            void reset(PositionIndex* fresh = nullptr) { index.reset(fresh); }
+            PositionIndex* operator->() const { return index.get(); }
+            explicit operator bool() const { return static_cast<bool>(index); }
+        };
+
+        /// @brief The optional value-to-positions index, rebuilt after each compaction.
+        mutable IndexHandle position_index;
+
+        /// @brief Tombstones for elements removed through the index but not yet compacted away.
+        mutable std::vector<bool> removed_flags;
+
+        /// @brief Number of tombstoned elements still stored in elements.
+        mutable size_t pending_removals = 0;
+
+        /// @brief Resets a container whose state was just moved out to a valid empty one.
+        /// @details The index went with the elements, so its tombstones must not stay behind.
+        ///          The version bump also restarts any order view still kept on this container.
+        void clear_moved_from() {
+            elements.clear();
+            removed_flags.clear();
+            pending_removals = 0;
+            sorted_cache.reset();
+            partial_cache.reset();
+            ++version;
+            ++storage_epoch.value;
+        }
+
+        /// @brief Physically erases tombstoned elements and shifts the survivors' indexed positions.
+        /// @details Does not change the logical contents, so the version stays the same. An index
+        ///          snapshot that is being maintained has its positions shifted to match.
+        void flush_removals() const {
+            if (pending_removals == 0) return;
+            removed_flags.resize(elements.size(), false);
+            std::vector<uint32_t> removed;
+            removed.reserve(pending_removals);
+            for (size_t i = 0; i < removed_flags.size(); ++i) {
+                if (removed_flags[i]) removed.push_back(static_cast<uint32_t>(i));
+            }
+            if (SortedView::by_index && sorted_view_current()) {
+                drop_positions(writable_view().positions, removed, true);
+            }
+            size_t out = 0;
+            for (size_t i = 0; i < elements.size(); ++i) {
+                if (removed_flags[i]) continue;
+                if (out != i) elements[out] = std::move(elements[i]);
+                ++out;
+            }
+            elements.erase(elements.begin() + out, elements.end());
+            removed_flags.clear();
+            pending_removals = 0;
+            if (position_index) {
+                position_index->shift(removed);
+            }
+        }
+
+        /// @brief Refills the position index from the current elements.
+        void rebuild_position_index() const {
+            position_index->clear();
+            for (size_t i = 0; i < elements.size(); ++i) {
+                position_index->insert(elements[i], i);
+            }
+        }
+
+        /// @brief Gets the elements with any pending removals applied.
+        const storage_type& live() const {
+            flush_removals();
+            return elements;
+        }
+
+        /// @brief Removes a value through the hash index, leaving tombstones for later compaction.
+        /// @return The number of occurrences removed.
+        size_t remove_indexed(const T& element) {
+            std::vector<size_t> found = position_index->extract(element);
+            if (found.empty()) return 0;
+            bool keep_view = maintain_sorted && sorted_view_current();
+            removed_flags.resize(elements.size(), false);
+            std::vector<uint32_t> removed;
+            removed.reserve(found.size());
+            for (size_t pos : found) {
+                removed_flags[pos] = true;
+                removed.push_back(static_cast<uint32_t>(pos));
+            }
+            pending_removals += found.size();
+            ++version;
+            if (keep_view) {
+                sorted_erase(element, removed, false);
+            }
+            return found.size();
+        }
+
+    public:
+
+        /*===============================================
+        Construction and Capacity
+        ===============================================*/
+
+        /// @brief Constructs an empty container.
+        MyContainer() = default;
+
+        /// @brief Constructs an empty container with room for a number of elements.
+        /// @param initial_capacity The number of elements to reserve storage for.
+        explicit MyContainer(size_t initial_capacity) {
+            elements.reserve(initial_capacity);
+        }
+
+        /// @brief Constructs an empty container that allocates through the given allocator.
+        /// @param alloc The allocator for the elements and the sorted snapshots.
+        explicit MyContainer(const allocator_type& alloc) : elements(alloc) {}
+
+        MyContainer(const MyContainer&) = default;
+        MyContainer& operator=(const MyContainer&) = default;
+
+        /// @brief Takes over another container's elements, views and hash index.
+        /// @details other is left empty with no pending removals, so it stays usable.
+        MyContainer(MyContainer&& other) noexcept(std::is_nothrow_move_constructible<storage_type>::value &&
+                                                  std::is_nothrow_move_constructible<view_handle>::value)
+            : elements(std::move(other.elements)), version(other.version),
+              sorted_cache(std::move(other.sorted_cache)), sorted_version(other.sorted_version),
+              partial_cache(std::move(other.partial_cache)), partial_version(other.partial_version),
+              partial_k(other.partial_k), partial_largest(other.partial_largest),
+              maintain_sorted(other.maintain_sorted), position_index(std::move(other.position_index)),
+              removed_flags(std::move(other.removed_flags)), pending_removals(other.pending_removals) {
+            other.clear_moved_from();
+        }
+
+        /// @brief Takes over another container's state; other is left empty, as by the move constructor.
+        MyContainer& operator=(MyContainer&& other) {
+            if (this != &other) {
+                elements = std::move(other.elements);
+                version = other.version;
+                storage_epoch = other.storage_epoch;
+                sorted_cache = std::move(other.sorted_cache);
+                sorted_version = other.sorted_version;
+                partial_cache = std::move(other.partial_cache);
+                partial_version = other.partial_version;
+                partial_k = other.partial_k;
+                partial_largest = other.partial_largest;
+                maintain_sorted = other.maintain_sorted;
+                position_index = std::move(other.position_index);
+                removed_flags = std::move(other.removed_flags);
+                pending_removals = other.pending_removals;
+                other.clear_moved_from();
+            }
+            return *this;
+        }
+
+    private:
+        struct SnapshotCopyTag {};
+
+        MyContainer(const MyContainer& other, SnapshotCopyTag)
+            : elements(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.elements.get_allocator())),
+              version(other.version) {
+            if (!other.sorted_view_current()) {
+                other.sorted_view();
+            }
+            // A value view already dropped the tombstoned elements, so copy around them and let
+            // the source defer its compaction, which also shifts every hash-index entry
+            if (SortedView::by_index || other.pending_removals * 8 > other.elements.size()) {
+                const storage_type& source = other.live();
+                elements.assign(source.begin(), source.end());
+            } else {
+                elements.reserve(other.elements.size() - other.pending_removals);
+                for (size_t i = 0; i < other.elements.size(); ++i) {
+                    if (i < other.removed_flags.size() && other.removed_flags[i]) continue;
+                    elements.push_back(other.elements[i]);
+                }
+            }
+            sorted_cache = other.sorted_cache;
+            sorted_version = version;
+        }
+
+    public:
+        /// @brief Copies the elements for readers, leaving the write-side state behind.
+        /// @details Builds the sorted view first if it is stale and shares it with the copy, so
+        ///          readers of the copy never sort. The hash index, its tombstones and the
+        ///          maintain_sorted_index() setting are not carried over, and while the
+        ///          tombstones are few the source keeps them rather than compacting on every copy.
+        ///          ConcurrentMyContainer publishes these copies.
+        MyContainer snapshot_copy() const { return MyContainer(*this, SnapshotCopyTag()); }
+
+        /// @brief Reserves storage so that bulk loads do not reallocate repeatedly.
+        /// @param new_capacity The minimum number of elements to hold without reallocating.
+        void reserve(size_t new_capacity) {
+            elements.reserve(new_capacity);
+            ++storage_epoch.value;
+        }
+
+        /// @brief Gets the number of elements the container can hold without reallocating.
+        size_t capacity() const {
+            return elements.capacity();
+        }
+
+        /// @brief Returns unused memory, e.g. after large remove sweeps.
+        /// @details Applies pending removals, shrinks the element storage and drops a sorted
+        ///          view that no longer matches the elements.
+        void shrink_to_fit() {
+            flush_removals();
+            elements.shrink_to_fit();
+            ++storage_epoch.value;
+            if (!sorted_view_current()) {
+                sorted_cache.reset();
+            }
+            if (partial_version != version) {
+                partial_cache.reset();
+            }
+        }
 
         /*===============================================
         Container Management 
         ===============================================*/
 
-        /// @brief Adds a new element to the container.
+        /// @brief Adds a copy of an element to the container.
         /// @param element The element to be added to the container.
-        void add(T element) {
+        void add(const T& element) {
+            bool keep_view = maintain_sorted && sorted_view_current();
             elements.push_back(element);
+            appended(elements.size() - 1, keep_view);
+        }
+
+        /// @brief Adds an element to the container, moving it into place.
+        /// @param element The element to be added to the container.
+        void add(T&& element) {
+            bool keep_view = maintain_sorted && sorted_view_current();
+            elements.push_back(std::move(element));
+            appended(elements.size() - 1, keep_view);
+        }
+
+        /// @brief Constructs a new element in place at the end of the container.
+        /// @param args The arguments forwarded to T's constructor.
+        template<typename... Args>
+        void emplace(Args&&... args) {
+            bool keep_view = maintain_sorted && sorted_view_current();
+            elements.emplace_back(std::forward<Args>(args)...);
+            appended(elements.size() - 1, keep_view);
+        }
+
+        /// @brief Adds every element of a range, reserving storage once for forward ranges.
+        /// @details A maintained sorted view is updated with one sort of the new tail and a merge.
+        ///          A range over the container's own elements is copied first, so appending
+        ///          the container to itself is safe.
+        /// @param first The beginning of the elements to add.
+        /// @param last The end of the elements to add.
+        template<typename InputIt>
+        void add_range(InputIt first, InputIt last) {
+            using reference = typename std::iterator_traits<InputIt>::reference;
+            using refers_to_elements = std::integral_constant<bool, std::is_lvalue_reference<reference>::value &&
+                std::is_same<typename std::decay<reference>::type, T>::value>;
+            if (starts_inside(first, last, refers_to_elements())) {
+                storage_type copied(elements.get_allocator());
+                copied.assign(first, last);
+                add_range(std::make_move_iterator(copied.begin()), std::make_move_iterator(copied.end()));
+                return;
+            }
+            bool keep_view = maintain_sorted && sorted_view_current();
+            size_t old_size = elements.size();
+            reserve_for(first, last, typename std::iterator_traits<InputIt>::iterator_category());
+            for (; first != last; ++first) {
+                elements.emplace_back(*first);
+            }
+            appended(old_size, keep_view);
         }
 
         /// @brief Removes all occurrences of a specific element from the container.
         /// @param element The value of the element to remove.
         /// @throws std::invalid_argument if the specified element is not found in the container.
+        /// @note With a hash index enabled the occurrences are found in O(1) expected time and
+        ///       tombstoned; the elements are compacted in one pass on the next read.
         void remove(T element) {
-            auto original_size = elements.size();
-            elements.erase(std::remove(elements.begin(), elements.end(), element), elements.end());
-            if (elements.size() == original_size) {
+            if (try_remove(element) == 0) {
                 throw std::invalid_argument("Element not found in container.");
             }
         }
 
+        /// @brief Removes all occurrences of a specific element without throwing.
+        /// @param element The value of the element to remove.
+        /// @return The number of occurrences removed, 0 if the element was not found.
+        size_t try_remove(const T& element) {
+            if (position_index) {
+                return remove_indexed(element);
+            }
+            return remove_if([&element](const T& value) { return value == element; });
+        }
+
+        /// @brief Removes every element matching a predicate in a single compaction pass.
+        /// @param pred A pure unary predicate; it is also applied to a maintained sorted view.
+        /// @return The number of elements removed.
+        template<typename Pred>
+        size_t remove_if(Pred pred) {
+            flush_removals();
+            bool keep_view = maintain_sorted && sorted_view_current();
+            std::vector<uint32_t> removed;
+            // Misses are common, so scan for the first match before doing any bookkeeping
+            size_t out = std::find_if(elements.cbegin(), elements.cend(), pred) - elements.cbegin();
+            for (size_t i = out; i < elements.size(); ++i) {
+                if (pred(static_cast<const T&>(elements[i]))) {
+                    if (keep_view && SortedView::by_index) removed.push_back(static_cast<uint32_t>(i));
+                    continue;
+                }
+                if (out != i) elements[out] = std::move(elements[i]);
+                ++out;
+            }
+            size_t count = elements.size() - out;
+            if (count == 0) return 0;
+            elements.erase(elements.begin() + out, elements.end());
+            ++version;
+            if (keep_view) {
+                SortedView& view = writable_view();
+                if (SortedView::by_index) {
+                    drop_positions(view.positions, removed, true);
+                } else {
+                    view.values.erase(std::remove_if(view.values.begin(), view.values.end(), pred), view.values.end());
+                }
+                sorted_version = version;
+            }
+            if (position_index) {
+                rebuild_position_index();
+            }
+            return count;
+        }
+
+        /// @brief Removes all occurrences of every value in a batch with one compaction pass.
+        /// @details Replaces k separate remove() scans with a single O(n log k) pass. With a hash
+        ///          index enabled, each value is tombstoned through the index instead.
+        /// @param first The beginning of the values to remove.
+        /// @param last The end of the values to remove.
+        /// @return The number of elements removed.
+        template<typename InputIt>
+        size_t erase_many(InputIt first, InputIt last) {
+            if (position_index) {
+                size_t count = 0;
+                for (; first != last; ++first) {
+                    count += remove_indexed(*first);
+                }
+                return count;
+            }
+            std::vector<T> batch(first, last);
+            std::sort(batch.begin(), batch.end());
+            return remove_if([&batch](const T& value) {
+                auto range = std::equal_range(batch.begin(), batch.end(), value);
+                return std::find(range.first, range.second, value) != range.second;
+            });
+        }
+
+        /// @brief Removes all occurrences of every value in a range with one compaction pass.
+        template<typename Range>
+        size_t erase_many(const Range& values) {
+            return erase_many(std::begin(values), std::end(values));
+        }
+
+        /// @brief Removes all occurrences of every listed value with one compaction pass.
+        size_t erase_many(std::initializer_list<T> values) {
+            return erase_many(values.begin(), values.end());
+        }
+
+        /// @brief Keeps the sorted view up to date across add() and remove() instead of re-sorting.
+        /// @details Once a sorted traversal has built the view, add() inserts into it by binary
+        ///          search and remove() erases from it, so the next sorted traversal is a plain scan.
+        /// @param enabled Whether to maintain the view incrementally (off by default).
+        void maintain_sorted_index(bool enabled = true) {
+            maintain_sorted = enabled;
+        }
+
+        /// @brief Enables a value-to-positions hash index so remove() avoids a linear scan.
+        /// @details Only instantiated when called, so T needs a hash only if the index is used.
+        /// @tparam Hash The hash functor for T.
+        template<typename Hash = std::hash<T>>
+        void enable_hash_index() {
+            flush_removals();
+            position_index.reset(new HashPositionIndex<Hash>());
+            rebuild_position_index();
+        }
+
+        /// @brief Applies pending removals and drops the hash index.
+        void disable_hash_index() {
+            flush_removals();
+            position_index.reset();
+        }
+
         /// @brief Gets the current number of elements in the container.
         /// @return The total number of elements as an integer.
         int size() const {
-            return elements.size();
+            return elements.size() - pending_removals;
         }
 
         /*========================== Iterator Definitions ==========================*/
@@ -61,18 +986,20 @@ namespace container {
         /// @brief An iterator that traverses the container in the original insertion order.
         class Order {
         private:
-            typename std::vector<T>::const_iterator current;
+            typename storage_type::const_iterator current;
 
         public:
-            using iterator_category = std::forward_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
             using value_type = T;
             using difference_type = std::ptrdiff_t;
             using pointer = const T*;
             using reference = const T&;
 
+            Order() = default;
+
             /// @brief Constructs an Order.
             /// @param ptr A const_iterator pointing to the element.
-            Order(typename std::vector<T>::const_iterator ptr) : current(ptr) {}
+            Order(typename storage_type::const_iterator ptr) : current(ptr) {}
 
             /// @brief Dereferences the iterator to get the element.
             /// @return A const reference to the element.
@@ -95,8 +1022,39 @@ namespace container {
                 return temp;
             }
 
+            Order& operator--() {
+                --current;
+                return *this;
+            }
+
+            Order operator--(int) {
+                Order temp = *this;
+                --(*this);
+                return temp;
+            }
+
+            Order& operator+=(difference_type n) {
+                current += n;
+                return *this;
+            }
+
+            Order& operator-=(difference_type n) {
+                current -= n;
+                return *this;
+            }
+
+            Order operator+(difference_type n) const { return Order(current + n); }
+            Order operator-(difference_type n) const { return Order(current - n); }
+            friend Order operator+(difference_type n, const Order& it) { return it + n; }
+            difference_type operator-(const Order& other) const { return current - other.current; }
+            reference operator[](difference_type n) const { return current[n]; }
+
             bool operator!=(const Order& other) const { return current != other.current; }
             bool operator==(const Order& other) const { return current == other.current; }
+            bool operator<(const Order& other) const { return current < other.current; }
+            bool operator>(const Order& other) const { return current > other.current; }
+            bool operator<=(const Order& other) const { return current <= other.current; }
+            bool operator>=(const Order& other) const { return current >= other.current; }
         };
 
         /*===============================================
@@ -106,18 +1064,26 @@ namespace container {
         /// @brief An iterator that traverses the container in the reverse of the insertion order.
         class ReverseOrder {
         private:
-            typename std::vector<T>::const_reverse_iterator current;
+            typename storage_type::const_reverse_iterator current;
         
         public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            ReverseOrder() = default;
+
             /// @brief Constructs a ReverseOrder.
             /// @param ptr A const_reverse_iterator pointing to the element.
-            ReverseOrder(typename std::vector<T>::const_reverse_iterator ptr) : current(ptr) {}
+            ReverseOrder(typename storage_type::const_reverse_iterator ptr) : current(ptr) {}
 
             /// @brief Dereferences the iterator to get the element.
-            const T& operator*() const { return *current; }
+            reference operator*() const { return *current; }
             
             /// @brief Provides pointer access to the element.
-            const T* operator->() const { return &(*current); }
+            pointer operator->() const { return &(*current); }
             
             /// @brief Advances the iterator to the next element (prefix).
             ReverseOrder& operator++() {
@@ -131,8 +1097,39 @@ namespace container {
                 return temp;
             }
 
+            ReverseOrder& operator--() {
+                --current;
+                return *this;
+            }
+
+            ReverseOrder operator--(int) {
+                ReverseOrder temp = *this;
+                --(*this);
+                return temp;
+            }
+
+            ReverseOrder& operator+=(difference_type n) {
+                current += n;
+                return *this;
+            }
+
+            ReverseOrder& operator-=(difference_type n) {
+                current -= n;
+                return *this;
+            }
+
+            ReverseOrder operator+(difference_type n) const { return ReverseOrder(current + n); }
+            ReverseOrder operator-(difference_type n) const { return ReverseOrder(current - n); }
+            friend ReverseOrder operator+(difference_type n, const ReverseOrder& it) { return it + n; }
+            difference_type operator-(const ReverseOrder& other) const { return current - other.current; }
+            reference operator[](difference_type n) const { return current[n]; }
+
             bool operator!=(const ReverseOrder& other) const { return current != other.current; }
             bool operator==(const ReverseOrder& other) const { return current == other.current; }
+            bool operator<(const ReverseOrder& other) const { return current < other.current; }
+            bool operator>(const ReverseOrder& other) const { return current > other.current; }
+            bool operator<=(const ReverseOrder& other) const { return current <= other.current; }
+            bool operator>=(const ReverseOrder& other) const { return current >= other.current; }
         };
 
         /*===============================================
@@ -142,32 +1139,82 @@ namespace container {
         /// @brief An iterator that traverses the container's elements in sorted ascending order.
         class AscendingOrder {
         private:
-            std::vector<T> sorted_elements;
-            size_t index;
+            view_handle sorted_elements;
+            const storage_type* source = nullptr;
+            size_t index = 0;
+
+            /// @brief Debug check that two iterators walk views of the same length, which fails
+            ///        e.g. for begin_ascending_order(k) compared with end_ascending_order().
+            bool comparable(const AscendingOrder& other) const {
+                return !sorted_elements || !other.sorted_elements || sorted_elements->size() == other.sorted_elements->size();
+            }
         public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            AscendingOrder() = default;
+
             /// @brief Constructs an AscendingOrder.
-            /// @param original_elements The container's elements to be sorted and traversed.
+            /// @param sorted The container's shared ascending-sorted view.
+            /// @param original_elements The container's elements, dereferenced by index snapshots.
             /// @param is_end Flag to indicate if this should be an end iterator.
-            explicit AscendingOrder(const std::vector<T>& original_elements, bool is_end = false) : sorted_elements(original_elements) {
-                std::sort(sorted_elements.begin(), sorted_elements.end());
-                this->index = is_end ? sorted_elements.size() : 0;
+            AscendingOrder(const view_handle& sorted, const storage_type& original_elements, bool is_end = false) : sorted_elements(sorted), source(&original_elements) {
+                this->index = is_end ? sorted_elements->size() : 0;
             }
 
-            const T& operator*() const { return sorted_elements[index]; }
+            reference operator*() const { return sorted_elements->at(index, *source); }
+            pointer operator->() const { return &**this; }
             
             AscendingOrder& operator++() {
                 ++index;
                 return *this;
             }
-            
+
             AscendingOrder operator++(int) {
                 AscendingOrder temp = *this;
                 ++(*this);
                 return temp;
             }
 
-            bool operator!=(const AscendingOrder& other) const { return this->index != other.index; }
-            bool operator==(const AscendingOrder& other) const { return this->index == other.index; }
+            AscendingOrder& operator--() {
+                --index;
+                return *this;
+            }
+
+            AscendingOrder operator--(int) {
+                AscendingOrder temp = *this;
+                --(*this);
+                return temp;
+            }
+
+            AscendingOrder& operator+=(difference_type n) {
+                index += n;
+                return *this;
+            }
+
+            AscendingOrder& operator-=(difference_type n) { return *this += -n; }
+            AscendingOrder operator+(difference_type n) const { AscendingOrder temp = *this; return temp += n; }
+            AscendingOrder operator-(difference_type n) const { AscendingOrder temp = *this; return temp -= n; }
+            friend AscendingOrder operator+(difference_type n, const AscendingOrder& it) { return it + n; }
+            difference_type operator-(const AscendingOrder& other) const {
+                assert(comparable(other));
+                return static_cast<difference_type>(this->index) - static_cast<difference_type>(other.index);
+            }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            bool operator!=(const AscendingOrder& other) const { assert(comparable(other)); return this->index != other.index; }
+            bool operator==(const AscendingOrder& other) const { assert(comparable(other)); return this->index == other.index; }
+            bool operator<(const AscendingOrder& other) const { assert(comparable(other)); return this->index < other.index; }
+            bool operator>(const AscendingOrder& other) const { assert(comparable(other)); return this->index > other.index; }
+            bool operator<=(const AscendingOrder& other) const { assert(comparable(other)); return this->index <= other.index; }
+            bool operator>=(const AscendingOrder& other) const { assert(comparable(other)); return this->index >= other.index; }
+            bool operator!=(EndSentinel) const { return this->index != sorted_elements->size(); }
+            bool operator==(EndSentinel) const { return this->index == sorted_elements->size(); }
+            friend bool operator!=(EndSentinel, const AscendingOrder& it) { return it != EndSentinel(); }
+            friend bool operator==(EndSentinel, const AscendingOrder& it) { return it == EndSentinel(); }
         };
 
         /*===============================================
@@ -177,18 +1224,33 @@ namespace container {
         /// @brief An iterator that traverses the container's elements in sorted descending order.
         class DescendingOrder {
         private:
-            std::vector<T> sorted_elements;
-            size_t index;
+            view_handle sorted_elements;
+            const storage_type* source = nullptr;
+            size_t index = 0;
+
+            /// @brief Debug check that two iterators walk views of the same length.
+            bool comparable(const DescendingOrder& other) const {
+                return !sorted_elements || !other.sorted_elements || sorted_elements->size() == other.sorted_elements->size();
+            }
         public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            DescendingOrder() = default;
+
             /// @brief Constructs a DescendingOrder.
-            /// @param original_elements The container's elements to be sorted and traversed.
+            /// @param sorted The container's shared ascending-sorted view, walked from the back.
+            /// @param original_elements The container's elements, dereferenced by index snapshots.
             /// @param is_end Flag to indicate if this should be an end iterator.
-            explicit DescendingOrder(const std::vector<T>& original_elements, bool is_end = false) : sorted_elements(original_elements) {
-                std::sort(sorted_elements.begin(), sorted_elements.end(), std::greater<T>());
-                this->index = is_end ? sorted_elements.size() : 0;
+            DescendingOrder(const view_handle& sorted, const storage_type& original_elements, bool is_end = false) : sorted_elements(sorted), source(&original_elements) {
+                this->index = is_end ? sorted_elements->size() : 0;
             }
 
-            const T& operator*() const { return sorted_elements[index]; }
+            reference operator*() const { return sorted_elements->at(sorted_elements->size() - 1 - index, *source); }
+            pointer operator->() const { return &**this; }
             
             DescendingOrder& operator++() {
                 ++index;
@@ -201,8 +1263,42 @@ namespace container {
                 return temp;
             }
 
-            bool operator!=(const DescendingOrder& other) const { return this->index != other.index; }
-            bool operator==(const DescendingOrder& other) const { return this->index == other.index; }
+            DescendingOrder& operator--() {
+                --index;
+                return *this;
+            }
+
+            DescendingOrder operator--(int) {
+                DescendingOrder temp = *this;
+                --(*this);
+                return temp;
+            }
+
+            DescendingOrder& operator+=(difference_type n) {
+                index += n;
+                return *this;
+            }
+
+            DescendingOrder& operator-=(difference_type n) { return *this += -n; }
+            DescendingOrder operator+(difference_type n) const { DescendingOrder temp = *this; return temp += n; }
+            DescendingOrder operator-(difference_type n) const { DescendingOrder temp = *this; return temp -= n; }
+            friend DescendingOrder operator+(difference_type n, const DescendingOrder& it) { return it + n; }
+            difference_type operator-(const DescendingOrder& other) const {
+                assert(comparable(other));
+                return static_cast<difference_type>(this->index) - static_cast<difference_type>(other.index);
+            }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            bool operator!=(const DescendingOrder& other) const { assert(comparable(other)); return this->index != other.index; }
+            bool operator==(const DescendingOrder& other) const { assert(comparable(other)); return this->index == other.index; }
+            bool operator<(const DescendingOrder& other) const { assert(comparable(other)); return this->index < other.index; }
+            bool operator>(const DescendingOrder& other) const { assert(comparable(other)); return this->index > other.index; }
+            bool operator<=(const DescendingOrder& other) const { assert(comparable(other)); return this->index <= other.index; }
+            bool operator>=(const DescendingOrder& other) const { assert(comparable(other)); return this->index >= other.index; }
+            bool operator!=(EndSentinel) const { return this->index != sorted_elements->size(); }
+            bool operator==(EndSentinel) const { return this->index == sorted_elements->size(); }
+            friend bool operator!=(EndSentinel, const DescendingOrder& it) { return it != EndSentinel(); }
+            friend bool operator==(EndSentinel, const DescendingOrder& it) { return it == EndSentinel(); }
         };
 
         /*===============================================
@@ -211,32 +1307,43 @@ namespace container {
         
         /// @brief An iterator that traverses elements by alternating between the smallest and largest.
         /// @details Traversal order is: first, last, second, second-to-last, and so on.
+        ///          Position k maps straight into the container's shared sorted view: even k reads
+        ///          sorted[k/2] and odd k reads sorted[n-1-k/2], so it costs the same as AscendingOrder.
         class SideCrossOrder {
         private:
-            std::vector<T> sorted_elements;
-            size_t left;
-            size_t right;
-            size_t count;
+            view_handle sorted_elements;
+            const storage_type* source = nullptr;
+            size_t index = 0;
+
+            /// @brief Debug check that two iterators walk views of the same length.
+            bool comparable(const SideCrossOrder& other) const {
+                return !sorted_elements || !other.sorted_elements || sorted_elements->size() == other.sorted_elements->size();
+            }
         public:
-            /// @brief Constructs a SideCrossOrder.cut
-            /// @param original_elements The container's elements to be sorted and traversed.
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            SideCrossOrder() = default;
+
+            /// @brief Constructs a SideCrossOrder.
+            /// @param sorted The container's shared ascending-sorted view.
+            /// @param original_elements The container's elements, dereferenced by index snapshots.
             /// @param is_end Flag to indicate if this should be an end iterator.
-            explicit SideCrossOrder(const std::vector<T>& original_elements, bool is_end = false) : sorted_elements(original_elements) {
-                std::sort(sorted_elements.begin(), sorted_elements.end());
-                this->left = 0;
-                this->right = sorted_elements.empty() ? 0 : sorted_elements.size() - 1;
-                this->count = is_end ? sorted_elements.size() : 0;
+            SideCrossOrder(const view_handle& sorted, const storage_type& original_elements, bool is_end = false) : sorted_elements(sorted), source(&original_elements) {
+                this->index = is_end ? sorted_elements->size() : 0;
             }
 
-            const T& operator*() const {
-                if (count % 2 == 0) return sorted_elements[left];
-                return sorted_elements[right];
+            reference operator*() const {
+                size_t k = (index % 2 == 0) ? index / 2 : sorted_elements->size() - 1 - index / 2;
+                return sorted_elements->at(k, *source);
             }
+            pointer operator->() const { return &**this; }
 
             SideCrossOrder& operator++() {
-                if (count % 2 == 0) left++;
-                else right--;
-                count++;
+                ++index;
                 return *this;
             }
 
@@ -246,8 +1353,42 @@ namespace container {
                 return temp;
             }
 
-            bool operator!=(const SideCrossOrder& other) const { return this->count != other.count; }
-            bool operator==(const SideCrossOrder& other) const { return this->count == other.count; }
+            SideCrossOrder& operator--() {
+                --index;
+                return *this;
+            }
+
+            SideCrossOrder operator--(int) {
+                SideCrossOrder temp = *this;
+                --(*this);
+                return temp;
+            }
+
+            SideCrossOrder& operator+=(difference_type n) {
+                index += n;
+                return *this;
+            }
+
+            SideCrossOrder& operator-=(difference_type n) { return *this += -n; }
+            SideCrossOrder operator+(difference_type n) const { SideCrossOrder temp = *this; return temp += n; }
+            SideCrossOrder operator-(difference_type n) const { SideCrossOrder temp = *this; return temp -= n; }
+            friend SideCrossOrder operator+(difference_type n, const SideCrossOrder& it) { return it + n; }
+            difference_type operator-(const SideCrossOrder& other) const {
+                assert(comparable(other));
+                return static_cast<difference_type>(this->index) - static_cast<difference_type>(other.index);
+            }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            bool operator!=(const SideCrossOrder& other) const { assert(comparable(other)); return this->index != other.index; }
+            bool operator==(const SideCrossOrder& other) const { assert(comparable(other)); return this->index == other.index; }
+            bool operator<(const SideCrossOrder& other) const { assert(comparable(other)); return this->index < other.index; }
+            bool operator>(const SideCrossOrder& other) const { assert(comparable(other)); return this->index > other.index; }
+            bool operator<=(const SideCrossOrder& other) const { assert(comparable(other)); return this->index <= other.index; }
+            bool operator>=(const SideCrossOrder& other) const { assert(comparable(other)); return this->index >= other.index; }
+            bool operator!=(EndSentinel) const { return this->index != sorted_elements->size(); }
+            bool operator==(EndSentinel) const { return this->index == sorted_elements->size(); }
+            friend bool operator!=(EndSentinel, const SideCrossOrder& it) { return it != EndSentinel(); }
+            friend bool operator==(EndSentinel, const SideCrossOrder& it) { return it == EndSentinel(); }
         };
 
         /*===============================================
@@ -256,53 +1397,187 @@ namespace container {
         
         /// @brief An iterator that traverses elements by spiraling outwards from the middle.
         /// @details Traversal order is: middle, element left of middle, element right of middle, etc.
+        ///          The k-th position is computed directly from k and the middle index, so no
+        ///          index table is built and begin, end and copies are all O(1).
         class MiddleOutOrder {
         private:
-            const std::vector<T>& original_elements_ref;
-            std::vector<size_t> traversal_indices;
-            size_t current_pos_in_indices;
+            const storage_type* original_elements_ref = nullptr;
+            size_t mid = 0;
+            size_t current_pos_in_indices = 0;
+            size_t total = 0;
+
+            /// @brief Maps a traversal position to an index into the elements.
+            /// @details The left side holds mid elements and the right side at least as many, so
+            ///          positions up to 2*mid alternate left (odd) and right (even) around mid; any
+            ///          remaining positions are the tail of the right side, which ends at index k.
+            size_t index_at(size_t k) const {
+                if (k > 2 * mid) return k;
+                return (k % 2 == 1) ? mid - (k + 1) / 2 : mid + k / 2;
+            }
         public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            MiddleOutOrder() = default;
+
             /// @brief Constructs a MiddleOutOrder.
             /// @param original_elements The container's elements to be traversed.
             /// @param is_end Flag to indicate if this should be an end iterator.
-            explicit MiddleOutOrder(const std::vector<T>& original_elements, bool is_end = false) : original_elements_ref(original_elements) {
+            explicit MiddleOutOrder(const storage_type& original_elements, bool is_end = false) : original_elements_ref(&original_elements) {
                 size_t n = original_elements.size();
-                if (n > 0) {
-                    traversal_indices.reserve(n);
-                    size_t mid = (n - 1) / 2;
-                    traversal_indices.push_back(mid);
-                    
-                    size_t l = mid - 1;
-                    size_t r = mid + 1;
-                    while (traversal_indices.size() < n) {
-                        if (l < n) { // Check for wrap around
-                            traversal_indices.push_back(l--);
-                        }
-                        if (r < n) {
-                            traversal_indices.push_back(r++);
-                        }
-                    }
-                }
+                this->mid = n > 0 ? (n - 1) / 2 : 0;
                 this->current_pos_in_indices = is_end ? n : 0;
+                this->total = n;
             }
 
-            const T& operator*() const {
-                return original_elements_ref[traversal_indices[current_pos_in_indices]];
+            reference operator*() const {
+                return (*original_elements_ref)[index_at(current_pos_in_indices)];
             }
+            pointer operator->() const { return &**this; }
             
             MiddleOutOrder& operator++() {
-                current_pos_in_indices++;
+                ++current_pos_in_indices;
                 return *this;
             }
-            
+
             MiddleOutOrder operator++(int) {
                 MiddleOutOrder temp = *this;
                 ++(*this);
                 return temp;
             }
 
+            MiddleOutOrder& operator--() {
+                --current_pos_in_indices;
+                return *this;
+            }
+
+            MiddleOutOrder operator--(int) {
+                MiddleOutOrder temp = *this;
+                --(*this);
+                return temp;
+            }
+
+            MiddleOutOrder& operator+=(difference_type n) {
+                current_pos_in_indices += n;
+                return *this;
+            }
+
+            MiddleOutOrder& operator-=(difference_type n) { return *this += -n; }
+            MiddleOutOrder operator+(difference_type n) const { MiddleOutOrder temp = *this; return temp += n; }
+            MiddleOutOrder operator-(difference_type n) const { MiddleOutOrder temp = *this; return temp -= n; }
+            friend MiddleOutOrder operator+(difference_type n, const MiddleOutOrder& it) { return it + n; }
+            difference_type operator-(const MiddleOutOrder& other) const {
+                return static_cast<difference_type>(this->current_pos_in_indices) - static_cast<difference_type>(other.current_pos_in_indices);
+            }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
             bool operator!=(const MiddleOutOrder& other) const { return this->current_pos_in_indices != other.current_pos_in_indices; }
             bool operator==(const MiddleOutOrder& other) const { return this->current_pos_in_indices == other.current_pos_in_indices; }
+            bool operator<(const MiddleOutOrder& other) const { return this->current_pos_in_indices < other.current_pos_in_indices; }
+            bool operator>(const MiddleOutOrder& other) const { return this->current_pos_in_indices > other.current_pos_in_indices; }
+            bool operator<=(const MiddleOutOrder& other) const { return this->current_pos_in_indices <= other.current_pos_in_indices; }
+            bool operator>=(const MiddleOutOrder& other) const { return this->current_pos_in_indices >= other.current_pos_in_indices; }
+            bool operator!=(EndSentinel) const { return this->current_pos_in_indices != this->total; }
+            bool operator==(EndSentinel) const { return this->current_pos_in_indices == this->total; }
+            friend bool operator!=(EndSentinel, const MiddleOutOrder& it) { return it != EndSentinel(); }
+            friend bool operator==(EndSentinel, const MiddleOutOrder& it) { return it == EndSentinel(); }
+        };
+
+        /*===============================================
+        Lazy Ascending Order
+        ===============================================*/
+
+        /// @brief An input iterator that yields the elements in ascending order, sorting on demand.
+        /// @details Heapifies the element positions in O(n) and pops the next smallest on each
+        ///          operator++ in O(log n), so reaching the first element costs O(n) and a loop
+        ///          that stops after k elements costs O(n + k log n) rather than a full sort.
+        ///          Copies share one heap, like std::istream_iterator, so copying is O(1) and
+        ///          advancing one copy advances them all; use begin_ascending_order() for a
+        ///          multi-pass order. Like MiddleOutOrder, it reads the container's elements in
+        ///          place, so it is invalidated by add() and remove().
+        class LazyAscendingOrder {
+        private:
+            /// @brief Orders positions so that the heap's front holds the smallest element.
+            struct Later {
+                const storage_type* source;
+                bool operator()(uint32_t a, uint32_t b) const { return (*source)[b] < (*source)[a]; }
+            };
+
+            /// @brief The positions not yet visited, as a min-heap on their elements.
+            struct Heap {
+                position_buffer positions;
+
+                explicit Heap(const allocator_type& alloc) : positions(rebind_alloc<uint32_t>(alloc)) {}
+            };
+
+            const storage_type* original_elements_ref = nullptr;
+            /// @brief Shared by every copy; null for an end iterator.
+            std::shared_ptr<Heap> heap;
+
+            size_t remaining() const { return heap ? heap->positions.size() : 0; }
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            /// @brief What operator++(int) returns: the element the iterator stood on.
+            /// @details Elements stay in place while the heap holds only their positions, so
+            ///          this keeps a pointer rather than a copy of the element.
+            class PostIncrementProxy {
+            private:
+                pointer element;
+            public:
+                explicit PostIncrementProxy(pointer element) : element(element) {}
+                reference operator*() const { return *element; }
+                pointer operator->() const { return element; }
+            };
+
+            LazyAscendingOrder() = default;
+
+            /// @brief Constructs a LazyAscendingOrder.
+            /// @param original_elements The container's elements to be traversed.
+            /// @param is_end Flag to indicate if this should be an end iterator.
+            explicit LazyAscendingOrder(const storage_type& original_elements, bool is_end = false)
+                : original_elements_ref(&original_elements) {
+                if (is_end || original_elements.empty()) return;
+                heap = std::allocate_shared<Heap>(rebind_alloc<Heap>(original_elements.get_allocator()),
+                                                  original_elements.get_allocator());
+                position_buffer& positions = heap->positions;
+                positions.resize(original_elements.size());
+                for (size_t i = 0; i < positions.size(); ++i) {
+                    positions[i] = static_cast<uint32_t>(i);
+                }
+                std::make_heap(positions.begin(), positions.end(), Later{original_elements_ref});
+            }
+
+            reference operator*() const { return (*original_elements_ref)[heap->positions.front()]; }
+            pointer operator->() const { return &**this; }
+
+            LazyAscendingOrder& operator++() {
+                position_buffer& positions = heap->positions;
+                std::pop_heap(positions.begin(), positions.end(), Later{original_elements_ref});
+                positions.pop_back();
+                return *this;
+            }
+
+            PostIncrementProxy operator++(int) {
+                PostIncrementProxy previous(&**this);
+                ++(*this);
+                return previous;
+            }
+
+            /// @brief Equal when both have the same number of elements left, e.g. both at the end.
+            bool operator!=(const LazyAscendingOrder& other) const { return this->remaining() != other.remaining(); }
+            bool operator==(const LazyAscendingOrder& other) const { return this->remaining() == other.remaining(); }
+            bool operator!=(EndSentinel) const { return remaining() != 0; }
+            bool operator==(EndSentinel) const { return remaining() == 0; }
+            friend bool operator!=(EndSentinel, const LazyAscendingOrder& it) { return it != EndSentinel(); }
+            friend bool operator==(EndSentinel, const LazyAscendingOrder& it) { return it == EndSentinel(); }
         };
 
         /*===============================================
@@ -314,42 +1589,248 @@ namespace container {
         Order end() const { return end_order(); }
 
         /// @brief Gets an iterator to the beginning of the insertion-order sequence.
-        Order begin_order() const { return Order(elements.cbegin()); }
+        Order begin_order() const { return Order(live().cbegin()); }
         /// @brief Gets an iterator to the end of the insertion-order sequence.
-        Order end_order() const { return Order(elements.cend()); }
+        Order end_order() const { return Order(live().cend()); }
         
         /// @brief Gets an iterator to the beginning of the reverse-order sequence.
-        ReverseOrder begin_reverse_order() const { return ReverseOrder(elements.crbegin()); }
+        ReverseOrder begin_reverse_order() const { return ReverseOrder(live().crbegin()); }
         /// @brief Gets an iterator to the end of the reverse-order sequence.
-        ReverseOrder end_reverse_order() const { return ReverseOrder(elements.crend()); }
+        ReverseOrder end_reverse_order() const { return ReverseOrder(live().crend()); }
 
         /// @brief Gets an iterator to the beginning of the ascending-order sequence.
-        AscendingOrder begin_ascending_order() const { return AscendingOrder(elements); }
+        AscendingOrder begin_ascending_order() const { return AscendingOrder(sorted_view(), live()); }
         /// @brief Gets an iterator to the end of the ascending-order sequence.
-        AscendingOrder end_ascending_order() const { return AscendingOrder(elements, true); }
+        AscendingOrder end_ascending_order() const { return AscendingOrder(sorted_view(), live(), true); }
+        /// @brief Gets an iterator to the beginning of the ascending-order sequence, sorting a
+        ///        stale view on several threads (e.g. begin_ascending_order(par)).
+        AscendingOrder begin_ascending_order(const ParallelPolicy& policy) const {
+            return AscendingOrder(sorted_view(&policy), live());
+        }
+        /// @brief Gets an iterator over only the k smallest elements, in ascending order.
+        /// @details Selects before sorting, so it costs O(n log k) at most instead of a full sort;
+        ///          end the loop with end_ascending_order(k) or end_sentinel(), never with
+        ///          end_ascending_order(), which ends the full order.
+        AscendingOrder begin_ascending_order(size_t k) const { return AscendingOrder(partial_view(k, false), live()); }
+        /// @brief Gets the end of the k smallest elements, to pair with begin_ascending_order(k).
+        /// @details Shares the view built by begin_ascending_order(k) while the container is unchanged.
+        AscendingOrder end_ascending_order(size_t k) const { return AscendingOrder(partial_view(k, false), live(), true); }
 
         /// @brief Gets an iterator to the beginning of the descending-order sequence.
-        DescendingOrder begin_descending_order() const { return DescendingOrder(elements); }
+        DescendingOrder begin_descending_order() const { return DescendingOrder(sorted_view(), live()); }
         /// @brief Gets an iterator to the end of the descending-order sequence.
-        DescendingOrder end_descending_order() const { return DescendingOrder(elements, true); }
+        DescendingOrder end_descending_order() const { return DescendingOrder(sorted_view(), live(), true); }
+        /// @brief Gets an iterator to the beginning of the descending-order sequence, sorting a
+        ///        stale view on several threads.
+        DescendingOrder begin_descending_order(const ParallelPolicy& policy) const {
+            return DescendingOrder(sorted_view(&policy), live());
+        }
+        /// @brief Gets an iterator over only the k largest elements, in descending order.
+        /// @details Selects before sorting, so it costs O(n log k) at most instead of a full sort;
+        ///          end the loop with end_descending_order(k) or end_sentinel().
+        DescendingOrder begin_descending_order(size_t k) const { return DescendingOrder(partial_view(k, true), live()); }
+        /// @brief Gets the end of the k largest elements, to pair with begin_descending_order(k).
+        DescendingOrder end_descending_order(size_t k) const { return DescendingOrder(partial_view(k, true), live(), true); }
+
+        /// @brief Gets the k largest elements, largest first (fewer if the container is smaller).
+        std::vector<T> top_k(size_t k) const {
+            std::vector<T> result;
+            for (DescendingOrder it = begin_descending_order(k); it != end_sentinel(); ++it) {
+                result.push_back(*it);
+            }
+            return result;
+        }
 
         /// @brief Gets an iterator to the beginning of the side-cross sequence.
-        SideCrossOrder begin_side_cross_order() const { return SideCrossOrder(elements); }
+        SideCrossOrder begin_side_cross_order() const { return SideCrossOrder(sorted_view(), live()); }
         /// @brief Gets an iterator to the end of the side-cross sequence.
-        SideCrossOrder end_side_cross_order() const { return SideCrossOrder(elements, true); }
+        SideCrossOrder end_side_cross_order() const { return SideCrossOrder(sorted_view(), live(), true); }
+        /// @brief Gets an iterator to the beginning of the side-cross sequence, sorting a stale
+        ///        view on several threads.
+        SideCrossOrder begin_side_cross_order(const ParallelPolicy& policy) const {
+            return SideCrossOrder(sorted_view(&policy), live());
+        }
 
         /// @brief Gets an iterator to the beginning of the middle-out sequence.
-        MiddleOutOrder begin_middle_out_order() const { return MiddleOutOrder(elements); }
+        MiddleOutOrder begin_middle_out_order() const { return MiddleOutOrder(live()); }
         /// @brief Gets an iterator to the end of the middle-out sequence.
-        MiddleOutOrder end_middle_out_order() const { return MiddleOutOrder(elements, true); }
+        MiddleOutOrder end_middle_out_order() const { return MiddleOutOrder(live(), true); }
+
+        /// @brief Gets an iterator to the beginning of the lazily sorted ascending sequence.
+        /// @details Time to the first element is O(n); prefer it over begin_ascending_order()
+        ///          for loops that stop after a few elements of a changing container.
+        LazyAscendingOrder begin_lazy_ascending_order() const { return LazyAscendingOrder(live()); }
+        /// @brief Gets an iterator to the end of the lazily sorted ascending sequence.
+        LazyAscendingOrder end_lazy_ascending_order() const { return LazyAscendingOrder(live(), true); }
+
+        /// @brief Gets the first iterator of the order named by a tag.
+        Order begin_in(InsertionOrderTag) const { return begin_order(); }
+        ReverseOrder begin_in(ReverseOrderTag) const { return begin_reverse_order(); }
+        AscendingOrder begin_in(AscendingOrderTag) const { return begin_ascending_order(); }
+        DescendingOrder begin_in(DescendingOrderTag) const { return begin_descending_order(); }
+        SideCrossOrder begin_in(SideCrossOrderTag) const { return begin_side_cross_order(); }
+        MiddleOutOrder begin_in(MiddleOutOrderTag) const { return begin_middle_out_order(); }
+
+        /*===============================================
+        Order Views
+        ===============================================*/
+
+        /// @brief A lazy view of one order that composes with the adaptors in Views.hpp.
+        /// @details Nothing is sorted until the first begin(). The iterator built then is kept,
+        ///          and end() is that iterator advanced, so a loop over the view takes a single
+        ///          snapshot. Once the container changes, or its storage moves through
+        ///          reserve(), shrink_to_fit(), assignment or a move out of it, the next begin()
+        ///          or end() starts over from the new elements, so a view can be kept and
+        ///          reused. A view must not outlive its container.
+        ///          views::take and views::drop fold into the view itself, so
+        ///          c.ascending() | views::take(k) sorts only the k smallest elements (see
+        ///          begin_ascending_order(size_t)), and likewise for descending().
+        template<typename OrderTag>
+        class OrderView {
+        public:
+            using iterator = decltype(std::declval<const MyContainer&>().begin_in(OrderTag()));
+
+        private:
+            const MyContainer* owner;
+            /// @brief Elements skipped by drop; offset + count never exceeds SIZE_MAX.
+            size_t offset = 0;
+            /// @brief Elements kept by take after the offset.
+            size_t count = static_cast<size_t>(-1);
+            mutable iterator first;
+            mutable size_t total = 0;
+            mutable bool started = false;
+            /// @brief The owner's version and storage epoch when first was built.
+            mutable size_t started_version = 0;
+            mutable size_t started_epoch = 0;
+
+            /// @brief Builds the first iterator; reach is how many leading elements are used.
+            template<typename Tag>
+            iterator start(size_t, Tag) const { return owner->begin_in(Tag()); }
+            iterator start(size_t reach, AscendingOrderTag) const {
+                return reach < total ? owner->begin_ascending_order(reach) : owner->begin_ascending_order();
+            }
+            iterator start(size_t reach, DescendingOrderTag) const {
+                return reach < total ? owner->begin_descending_order(reach) : owner->begin_descending_order();
+            }
+
+            const iterator& started_first() const {
+                if (!started || started_version != owner->version || started_epoch != owner->storage_epoch.value) {
+                    total = static_cast<size_t>(owner->size());
+                    first = start(offset + count, OrderTag());
+                    started = true;
+                    started_version = owner->version;
+                    started_epoch = owner->storage_epoch.value;
+                }
+                return first;
+            }
+
+        public:
+            explicit OrderView(const MyContainer& owner) : owner(&owner) {}
+
+            iterator begin() const {
+                const iterator& it = started_first();
+                return it + static_cast<std::ptrdiff_t>(std::min(offset, total));
+            }
+
+            iterator end() const {
+                const iterator& it = started_first();
+                return it + static_cast<std::ptrdiff_t>(std::min(offset + count, total));
+            }
+
+            /// @brief Gets the number of elements the view yields.
+            size_t size() const { return static_cast<size_t>(end() - begin()); }
+            bool empty() const { return size() == 0; }
+
+            friend OrderView operator|(OrderView view, views::TakeAdaptor take) {
+                view.count = std::min(view.count, take.count);
+                view.started = false;
+                return view;
+            }
+
+            friend OrderView operator|(OrderView view, views::DropAdaptor drop) {
+                size_t skipped = std::min(view.count, drop.count);
+                view.offset += skipped;
+                view.count -= skipped;
+                view.started = false;
+                return view;
+            }
+        };
+
+        /// @brief Gets a lazy view of the reverse insertion order.
+        OrderView<ReverseOrderTag> reversed() const { return OrderView<ReverseOrderTag>(*this); }
+        /// @brief Gets a lazy view of the ascending order, e.g. c.ascending() | views::take(10).
+        OrderView<AscendingOrderTag> ascending() const { return OrderView<AscendingOrderTag>(*this); }
+        /// @brief Gets a lazy view of the descending order.
+        OrderView<DescendingOrderTag> descending() const { return OrderView<DescendingOrderTag>(*this); }
+        /// @brief Gets a lazy view of the side-cross order.
+        OrderView<SideCrossOrderTag> side_cross() const { return OrderView<SideCrossOrderTag>(*this); }
+        /// @brief Gets a lazy view of the middle-out order.
+        OrderView<MiddleOutOrderTag> middle_out() const { return OrderView<MiddleOutOrderTag>(*this); }
+
+        /// @brief Calls fn(position, element) for every element of an order, on several threads.
+        /// @details Every order is random access, so the position space [0, size()) is split into
+        ///          chunks that threads claim dynamically; each chunk seeks its start once and then
+        ///          steps forward. position is the element's index within the order. fn runs
+        ///          concurrently and must not modify the container. The first exception thrown
+        ///          by fn is rethrown here.
+        /// @param order An order tag, e.g. orders::middle_out.
+        /// @param fn Called as fn(size_t position, const T& element).
+        /// @param threads The number of threads, or 0 for std::thread::hardware_concurrency().
+        template<typename OrderTag, typename Fn>
+        void parallel_for_each(OrderTag order, Fn fn, unsigned threads = 0) const {
+            auto first = begin_in(order);
+            parallel_for_chunks(live().size(), threads, [&first, &fn](size_t lo, size_t hi) {
+                auto it = first + static_cast<std::ptrdiff_t>(lo);
+                for (size_t k = lo; k < hi; ++k, ++it) {
+                    fn(k, *it);
+                }
+            });
+        }
+
+#if defined(CONTAINER_HAS_RANGES)
+        /// @brief Gets the order named by a tag as a sized C++20 range that ends in std::default_sentinel.
+        /// @details Composes with the standard views without building an end iterator, e.g.
+        ///          c.range_in(orders::ascending) | std::views::take(3). The insertion and reverse
+        ///          orders have overloads below, since their iterators do not know where they end.
+        template<typename OrderTag>
+        auto range_in(OrderTag order) const {
+            auto first = begin_in(order);
+            return std::ranges::subrange<decltype(first), std::default_sentinel_t, std::ranges::subrange_kind::sized>(
+                first, std::default_sentinel, live().size());
+        }
+
+        /// @brief Gets the insertion order as a C++20 range of begin and end iterators.
+        std::ranges::subrange<Order> range_in(InsertionOrderTag) const {
+            return std::ranges::subrange<Order>(begin_order(), end_order());
+        }
+
+        /// @brief Gets the reverse insertion order as a C++20 range of begin and end iterators.
+        std::ranges::subrange<ReverseOrder> range_in(ReverseOrderTag) const {
+            return std::ranges::subrange<ReverseOrder>(begin_reverse_order(), end_reverse_order());
+        }
+#endif
+
+        /// @brief Gets an allocation-free end marker for the ascending, descending,
+        ///        side-cross, middle-out and lazy ascending sequences.
+        /// @details Usage: for (auto it = c.begin_ascending_order(); it != c.end_sentinel(); ++it)
+        EndSentinel end_sentinel() const { return EndSentinel(); }
     };
 
+#if defined(CONTAINER_HAS_PMR)
+    namespace pmr {
+        /// @brief A MyContainer whose elements and sorted snapshots come from a
+        ///        std::pmr::memory_resource, e.g. a pool that recycles the buffers of rebuilt views.
+        template<typename T>
+        using MyContainer = container::MyContainer<T, std::pmr::polymorphic_allocator<T>>;
+    } // namespace pmr
+#endif
+
     /// @brief Overloads the << operator for easy printing of MyContainer contents.
     /// @param os The output stream.
     /// @param container The MyContainer to be printed.
     /// @return A reference to the output stream.
-    template<typename T>
-    std::ostream& operator<<(std::ostream& os, const MyContainer<T>& container) {
+    template<typename T, typename Alloc>
+    std::ostream& operator<<(std::ostream& os, const MyContainer<T, Alloc>& container) {
         os << "[";
         bool first = true;
         for (const T& element : container) {
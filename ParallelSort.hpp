@@ -0,0 +1,219 @@
+// meirshuker15@gmail.com
+//ParallelSort.hpp
+//Description: An execution policy, a multi-threaded merge sort and a chunked parallel loop.
+//MyContainer::begin_ascending_order(par) and its siblings build the sorted view with
+//parallel_sort() when the view has to be rebuilt; MyContainer::parallel_for_each() runs on
+//parallel_for_chunks(). Defining CONTAINER_PARALLEL_STL under C++17 or later hands comparison
+//sorts to the standard library's parallel algorithms instead (libstdc++ needs -ltbb for them).
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(CONTAINER_PARALLEL_STL) && __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<execution>)
+#include <execution>
+#define CONTAINER_HAS_EXECUTION 1
+#endif
+#endif
+
+namespace container {
+
+    /// @brief Requests that a sorted view be built on several threads.
+    /// @details Pass the predefined `par` for the defaults, or construct one to pick the thread
+    ///          count and the size below which sorting stays serial.
+    struct ParallelPolicy {
+        /// @brief Worker threads to use, or 0 for std::thread::hardware_concurrency().
+        unsigned threads;
+        /// @brief Ranges smaller than this are sorted on the calling thread.
+        size_t threshold;
+
+        explicit ParallelPolicy(unsigned threads = 0, size_t threshold = 100000)
+            : threads(threads), threshold(threshold) {}
+
+        /// @brief Gets the number of threads this policy resolves to (at least 1).
+        unsigned thread_count() const {
+            unsigned count = threads != 0 ? threads : std::thread::hardware_concurrency();
+            return count != 0 ? count : 1;
+        }
+    };
+
+    /// @brief The default parallel policy: every hardware thread, default threshold.
+    const ParallelPolicy par;
+
+    namespace detail {
+
+        /// @brief Runs task(0) .. task(count - 1), each on its own thread; task(0) runs on the caller.
+        template<typename Task>
+        void run_tasks(size_t count, Task task) {
+            std::vector<std::thread> workers;
+            workers.reserve(count);
+            for (size_t i = 1; i < count; ++i) {
+                workers.emplace_back(task, i);
+            }
+            if (count > 0) {
+                task(0);
+            }
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        /// @brief One slice of a merge round: merge [a, a_end) and [b, b_end) into out.
+        template<typename T>
+        struct MergeSlice {
+            T* a;
+            T* a_end;
+            T* b;
+            T* b_end;
+            T* out;
+        };
+    } // namespace detail
+
+    /// @brief Sorts a contiguous range with a parallel merge sort.
+    /// @details The range is cut into one chunk per thread and every chunk is sorted with
+    ///          serial_sort. Then log2(threads) merge rounds ping-pong between the range and a
+    ///          scratch buffer. Each round cuts its merges into about one slice per thread by
+    ///          binary search, so every round keeps all threads busy. Threads are started per
+    ///          call; that cost only matters below the policy's threshold, which sorts serially.
+    /// @param first The beginning of the range.
+    /// @param last The end of the range.
+    /// @param comp The strict weak ordering.
+    /// @param serial_sort Sorts one chunk, e.g. sort_values or std::sort with comp.
+    /// @param policy The thread count and serial threshold.
+    template<typename T, typename Compare, typename SerialSort>
+    void parallel_sort(T* first, T* last, Compare comp, SerialSort serial_sort, const ParallelPolicy& policy) {
+        const size_t n = static_cast<size_t>(last - first);
+        size_t threads = std::min<size_t>(policy.thread_count(), n / 2 + 1);
+        if (n < policy.threshold || threads < 2) {
+            serial_sort(first, last);
+            return;
+        }
+
+        std::vector<size_t> bounds;
+        for (size_t i = 0; i <= threads; ++i) {
+            bounds.push_back(n * i / threads);
+        }
+        // The values move into the scratch buffer; the range keeps valid objects to assign to
+        std::vector<T> scratch(std::make_move_iterator(first), std::make_move_iterator(last));
+        T* source = scratch.data();
+        T* target = first;
+        detail::run_tasks(threads, [&](size_t i) {
+            serial_sort(source + bounds[i], source + bounds[i + 1]);
+        });
+
+        while (bounds.size() > 2) {
+            std::vector<detail::MergeSlice<T>> slices;
+            std::vector<size_t> merged_bounds;
+            size_t pairs = (bounds.size() - 1) / 2;
+            size_t pieces = std::max<size_t>(1, threads / std::max<size_t>(1, pairs));
+            for (size_t r = 0; r + 1 < bounds.size(); r += 2) {
+                merged_bounds.push_back(bounds[r]);
+                T* a = source + bounds[r];
+                if (r + 2 >= bounds.size()) {
+                    // An unpaired last run is carried over as it is
+                    T* a_end = source + bounds[r + 1];
+                    slices.push_back({a, a_end, a_end, a_end, target + bounds[r]});
+                    continue;
+                }
+                T* a_end = source + bounds[r + 1];
+                T* b = a_end;
+                T* b_end = source + bounds[r + 2];
+                T* prev_a = a;
+                T* prev_b = b;
+                for (size_t p = 1; p <= pieces; ++p) {
+                    T* split_a = p == pieces ? a_end : a + (a_end - a) * p / pieces;
+                    T* split_b = p == pieces || split_a == a_end ? b_end : std::lower_bound(b, b_end, *split_a, comp);
+                    T* out = target + bounds[r] + (prev_a - a) + (prev_b - b);
+                    slices.push_back({prev_a, split_a, prev_b, split_b, out});
+                    prev_a = split_a;
+                    prev_b = split_b;
+                }
+            }
+            merged_bounds.push_back(n);
+
+            detail::run_tasks(slices.size(), [&](size_t i) {
+                const detail::MergeSlice<T>& s = slices[i];
+                std::merge(std::make_move_iterator(s.a), std::make_move_iterator(s.a_end),
+                           std::make_move_iterator(s.b), std::make_move_iterator(s.b_end), s.out, comp);
+            });
+            bounds.swap(merged_bounds);
+            std::swap(source, target);
+        }
+
+        if (source != first) {
+            detail::run_tasks(threads, [&](size_t i) {
+                std::move(source + n * i / threads, source + n * (i + 1) / threads, first + n * i / threads);
+            });
+        }
+    }
+
+    /// @brief Sorts a contiguous range by comparisons on several threads.
+    /// @details With CONTAINER_PARALLEL_STL under C++17, a policy that leaves the thread count
+    ///          to the implementation (threads == 0) sorts ranges past its threshold with
+    ///          std::sort(std::execution::par_unseq), which runs on the library's own thread
+    ///          pool rather than starting threads per call. comp and the element moves must
+    ///          then not lock or throw. Otherwise, and for explicit thread counts, the range
+    ///          goes to parallel_sort() with std::sort per chunk.
+    /// @param first The beginning of the range.
+    /// @param last The end of the range.
+    /// @param comp The strict weak ordering.
+    /// @param policy The thread count and serial threshold.
+    template<typename T, typename Compare>
+    void parallel_comparison_sort(T* first, T* last, Compare comp, const ParallelPolicy& policy) {
+#if defined(CONTAINER_HAS_EXECUTION)
+        if (policy.threads == 0 && static_cast<size_t>(last - first) >= policy.threshold) {
+            std::sort(std::execution::par_unseq, first, last, comp);
+            return;
+        }
+#endif
+        parallel_sort(first, last, comp, [&comp](T* begin, T* end) { std::sort(begin, end, comp); }, policy);
+    }
+
+    /// @brief Calls body(first, last) over [0, n) in chunks, on several threads.
+    /// @details Chunks are handed out dynamically from a shared counter, so a thread that
+    ///          finishes early takes the next chunk instead of idling while others run long
+    ///          ones. The first exception thrown by body stops the remaining chunks and is
+    ///          rethrown on the calling thread once every worker has stopped.
+    /// @param n The size of the index space.
+    /// @param threads The number of threads, or 0 for std::thread::hardware_concurrency().
+    /// @param body Called with the half-open index range of one chunk.
+    template<typename Body>
+    void parallel_for_chunks(size_t n, unsigned threads, Body body) {
+        if (n == 0) return;
+        size_t workers = ParallelPolicy(threads).thread_count();
+        // About 16 chunks per thread balances uneven work without much scheduling traffic
+        size_t chunk = std::max<size_t>(1, n / (workers * 16));
+        size_t chunks = (n + chunk - 1) / chunk;
+        workers = std::min(workers, chunks);
+
+        std::atomic<size_t> next_chunk(0);
+        std::atomic<bool> failed(false);
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        detail::run_tasks(workers, [&](size_t) {
+            for (size_t c = next_chunk++; c < chunks && !failed; c = next_chunk++) {
+                try {
+                    body(c * chunk, std::min(n, (c + 1) * chunk));
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+        });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+} // namespace container
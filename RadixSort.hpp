@@ -0,0 +1,564 @@
+// meirshuker15@gmail.com
+//RadixSort.hpp
+//Description: Sorting kernels for fixed-width arithmetic keys: an LSD radix sort for large
+//ranges and a branchless sorting network plus merge for small ones. On x86-64 the network
+//runs on AVX2 or AVX-512 registers when the CPU supports them, checked once at run time.
+//MyContainer builds its sorted view with sort_values(), which picks these kernels at
+//compile time for integral and floating-point element types and std::sort for the rest.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CONTAINER_HAS_SIMD_SORT 1
+#include <immintrin.h>
+#endif
+
+namespace container {
+
+    /// @brief Selects whether sort_values() radix-sorts a type.
+    /// @details True for 1, 2, 4 and 8 byte arithmetic types except bool. long double is
+    ///          excluded since its padding bytes do not take part in the ordering.
+    template<typename T>
+    struct radix_sortable : std::integral_constant<bool,
+        std::is_arithmetic<T>::value &&
+        !std::is_same<typename std::remove_cv<T>::type, bool>::value &&
+        !std::is_same<typename std::remove_cv<T>::type, long double>::value &&
+        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {};
+
+    namespace detail {
+
+        template<size_t Bytes> struct unsigned_bits;
+        template<> struct unsigned_bits<1> { using type = uint8_t; };
+        template<> struct unsigned_bits<2> { using type = uint16_t; };
+        template<> struct unsigned_bits<4> { using type = uint32_t; };
+        template<> struct unsigned_bits<8> { using type = uint64_t; };
+
+        /// @brief How a type's bit pattern has to be adjusted to sort as an unsigned integer.
+        enum class key_kind { plain, sign_bit, floating };
+
+        template<typename T>
+        struct key_kind_of : std::integral_constant<key_kind,
+            std::is_floating_point<T>::value ? key_kind::floating :
+            std::is_signed<T>::value ? key_kind::sign_bit : key_kind::plain> {};
+
+        template<typename Key>
+        Key flip_mask(Key, std::integral_constant<key_kind, key_kind::plain>) {
+            return 0;
+        }
+
+        /// @brief Signed integers: flipping the sign bit moves negatives below positives.
+        template<typename Key>
+        Key flip_mask(Key, std::integral_constant<key_kind, key_kind::sign_bit>) {
+            return static_cast<Key>(Key(1) << (sizeof(Key) * 8 - 1));
+        }
+
+        /// @brief IEEE floats: negatives flip every bit (reversing their order), positives
+        ///        flip only the sign bit.
+        template<typename Key>
+        Key flip_mask(Key key, std::integral_constant<key_kind, key_kind::floating>) {
+            const Key sign = static_cast<Key>(Key(1) << (sizeof(Key) * 8 - 1));
+            return (key & sign) ? static_cast<Key>(~Key(0)) : sign;
+        }
+
+        /// @brief Maps a value to an unsigned key with the same ordering.
+        template<typename T>
+        typename unsigned_bits<sizeof(T)>::type radix_key(const T& value) {
+            using Key = typename unsigned_bits<sizeof(T)>::type;
+            Key key;
+            std::memcpy(&key, &value, sizeof(T));
+            return static_cast<Key>(key ^ flip_mask(key, key_kind_of<T>()));
+        }
+
+        /// @brief Inverts radix_key() for floating-point types.
+        template<typename T>
+        T from_radix_key(typename unsigned_bits<sizeof(T)>::type key) {
+            using Key = typename unsigned_bits<sizeof(T)>::type;
+            const Key sign = static_cast<Key>(Key(1) << (sizeof(Key) * 8 - 1));
+            key = static_cast<Key>((key & sign) ? key ^ sign : ~key);
+            T value;
+            std::memcpy(&value, &key, sizeof(T));
+            return value;
+        }
+    } // namespace detail
+
+    /// @brief Below this many elements sort_values() uses network_sort() instead of the radix
+    ///        sort, which is faster on small inputs and needs no heap scratch buffer.
+    const size_t radix_sort_threshold = 256;
+
+    /// @brief Sorts a contiguous range of arithmetic values ascending with an LSD radix sort.
+    /// @details One pass builds all byte histograms, then one stable scatter per byte, skipping
+    ///          bytes that are the same in every key (e.g. the high bytes of small integers).
+    ///          Uses a scratch buffer of n elements. NaNs sort by their bit pattern.
+    /// @param first The beginning of the range.
+    /// @param last The end of the range.
+    template<typename T>
+    void radix_sort(T* first, T* last) {
+        static_assert(radix_sortable<T>::value, "radix_sort needs a fixed-width arithmetic type");
+        const size_t bytes = sizeof(T);
+        const size_t n = static_cast<size_t>(last - first);
+        if (n < 2) return;
+
+        std::vector<size_t> counts(bytes * 256, 0);
+        for (T* it = first; it != last; ++it) {
+            auto key = detail::radix_key(*it);
+            for (size_t b = 0; b < bytes; ++b) {
+                ++counts[b * 256 + ((key >> (b * 8)) & 0xFF)];
+            }
+        }
+
+        std::vector<T> scratch(n);
+        T* source = first;
+        T* target = scratch.data();
+        for (size_t b = 0; b < bytes; ++b) {
+            size_t* count = &counts[b * 256];
+            // A byte shared by every key leaves the order unchanged
+            if (count[(detail::radix_key(*first) >> (b * 8)) & 0xFF] == n) continue;
+
+            size_t offset = 0;
+            for (size_t d = 0; d < 256; ++d) {
+                size_t c = count[d];
+                count[d] = offset;
+                offset += c;
+            }
+            for (T* it = source; it != source + n; ++it) {
+                target[count[(detail::radix_key(*it) >> (b * 8)) & 0xFF]++] = *it;
+            }
+            std::swap(source, target);
+        }
+        if (source != first) {
+            std::copy(source, source + n, first);
+        }
+    }
+
+    namespace detail {
+
+        /// @brief Orders two values without a branch; compiles to min/max or cmov.
+        template<typename T>
+        inline void compare_exchange(T& a, T& b) {
+            const T low = b < a ? b : a;
+            const T high = b < a ? a : b;
+            a = low;
+            b = high;
+        }
+
+        /// @brief Sorts 8 values with the optimal 19-comparator network.
+        template<typename T>
+        void sort8(T* v) {
+            compare_exchange(v[0], v[2]); compare_exchange(v[1], v[3]);
+            compare_exchange(v[4], v[6]); compare_exchange(v[5], v[7]);
+            compare_exchange(v[0], v[4]); compare_exchange(v[1], v[5]);
+            compare_exchange(v[2], v[6]); compare_exchange(v[3], v[7]);
+            compare_exchange(v[0], v[1]); compare_exchange(v[2], v[3]);
+            compare_exchange(v[4], v[5]); compare_exchange(v[6], v[7]);
+            compare_exchange(v[2], v[4]); compare_exchange(v[3], v[5]);
+            compare_exchange(v[1], v[4]); compare_exchange(v[3], v[6]);
+            compare_exchange(v[1], v[2]); compare_exchange(v[3], v[4]); compare_exchange(v[5], v[6]);
+        }
+
+        /// @brief Insertion sort for the last block of fewer than 8 values.
+        template<typename T>
+        void insertion_sort(T* first, T* last) {
+            for (T* it = first + 1; it < last; ++it) {
+                T value = *it;
+                T* hole = it;
+                for (; hole != first && value < hole[-1]; --hole) {
+                    *hole = hole[-1];
+                }
+                *hole = value;
+            }
+        }
+
+        /// @brief Merges two sorted runs, advancing one of them per step without a branch.
+        template<typename T>
+        void merge_runs(const T* a, const T* a_end, const T* b, const T* b_end, T* out) {
+            while (a != a_end && b != b_end) {
+                const bool take_b = *b < *a;
+                *out++ = *(take_b ? b : a); // select the pointer, not the value
+                b += take_b;
+                a += !take_b;
+            }
+            out = std::copy(a, a_end, out);
+            std::copy(b, b_end, out);
+        }
+    } // namespace detail
+
+    /// @brief The instruction set the sorting network runs on.
+    /// @details avx2 sorts and merges 32-bit keys eight at a time in 256-bit registers;
+    ///          avx512 adds the same for 64-bit keys, which AVX2 has no min/max
+    ///          instructions for. 8 and 16-bit keys always use the scalar network.
+    enum class sort_kernel { scalar, avx2, avx512 };
+
+    /// @brief Gets the fastest sort_kernel this CPU supports, checked with CPUID once.
+    inline sort_kernel best_sort_kernel() {
+#if defined(CONTAINER_HAS_SIMD_SORT)
+        static const sort_kernel best = [] {
+            __builtin_cpu_init();
+            if (!__builtin_cpu_supports("avx2")) return sort_kernel::scalar;
+            return __builtin_cpu_supports("avx512f") ? sort_kernel::avx512 : sort_kernel::avx2;
+        }();
+        return best;
+#else
+        return sort_kernel::scalar;
+#endif
+    }
+
+    namespace detail {
+
+        /// @brief Sorts each block of 8 in [first, first + n) with the scalar network.
+        template<typename T>
+        void sort_blocks(T* first, size_t n) {
+            for (size_t i = 0; i + 8 <= n; i += 8) {
+                sort8(first + i);
+            }
+        }
+
+#if defined(CONTAINER_HAS_SIMD_SORT)
+#if defined(__GNUC__) && !defined(__clang__)
+        // GCC's AVX-512 intrinsics start from _mm512_undefined_epi32(), a self-initialised
+        // variable that -Wuninitialized reports once the intrinsic is inlined here
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+        /// @brief Runs the 19-comparator network across eight registers: lane j of r[0..7]
+        ///        is one column of 8 keys, so every lane is sorted at once.
+        /// @details Always inlined, so that the compare-exchanges inline into the caller's
+        ///          target instruction set.
+        template<typename Vector, typename Ops>
+        __attribute__((always_inline)) inline void network8(Vector* r, Ops ops) {
+            ops.compare_exchange(r[0], r[2]); ops.compare_exchange(r[1], r[3]);
+            ops.compare_exchange(r[4], r[6]); ops.compare_exchange(r[5], r[7]);
+            ops.compare_exchange(r[0], r[4]); ops.compare_exchange(r[1], r[5]);
+            ops.compare_exchange(r[2], r[6]); ops.compare_exchange(r[3], r[7]);
+            ops.compare_exchange(r[0], r[1]); ops.compare_exchange(r[2], r[3]);
+            ops.compare_exchange(r[4], r[5]); ops.compare_exchange(r[6], r[7]);
+            ops.compare_exchange(r[2], r[4]); ops.compare_exchange(r[3], r[5]);
+            ops.compare_exchange(r[1], r[4]); ops.compare_exchange(r[3], r[6]);
+            ops.compare_exchange(r[1], r[2]); ops.compare_exchange(r[3], r[4]); ops.compare_exchange(r[5], r[6]);
+        }
+
+        /// @brief 8 32-bit keys per AVX2 register.
+        template<bool Signed>
+        struct avx2_keys32 {
+            using vector = __m256i;
+
+            __attribute__((target("avx2"))) void load(vector& v, const void* p) const {
+                v = _mm256_loadu_si256(static_cast<const __m256i*>(p));
+            }
+
+            __attribute__((target("avx2"))) void store(void* p, const vector& v) const {
+                _mm256_storeu_si256(static_cast<__m256i*>(p), v);
+            }
+
+            __attribute__((target("avx2"))) void compare_exchange(vector& a, vector& b) const {
+                const __m256i low = Signed ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b);
+                b = Signed ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b);
+                a = low;
+            }
+
+            /// @brief Sorts a bitonic register: lane i meets lane i ^ 4, then i ^ 2, then i ^ 1.
+            __attribute__((target("avx2"))) void bitonic_clean(vector& x) const {
+                __m256i t = _mm256_permute2x128_si256(x, x, 0x01);
+                compare_exchange(x, t);
+                x = _mm256_blend_epi32(x, t, 0xF0);
+                t = _mm256_shuffle_epi32(x, 0x4E);
+                compare_exchange(x, t);
+                x = _mm256_blend_epi32(x, t, 0xCC);
+                t = _mm256_shuffle_epi32(x, 0xB1);
+                compare_exchange(x, t);
+                x = _mm256_blend_epi32(x, t, 0xAA);
+            }
+
+            /// @brief Merges two sorted registers: a gets the 8 smallest keys, b the 8 largest.
+            __attribute__((target("avx2"))) void merge(vector& a, vector& b) const {
+                b = _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+                compare_exchange(a, b);
+                bitonic_clean(a);
+                bitonic_clean(b);
+            }
+
+            /// @brief Turns the sorted columns of r into 8 sorted runs of 8 at v.
+            __attribute__((target("avx2"))) void transpose_store(void* v, const vector* r) const {
+                __m256i t[8];
+                for (int i = 0; i < 8; i += 2) {
+                    t[i] = _mm256_unpacklo_epi32(r[i], r[i + 1]);
+                    t[i + 1] = _mm256_unpackhi_epi32(r[i], r[i + 1]);
+                }
+                __m256i u[8];
+                for (int i = 0; i < 8; i += 4) {
+                    u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+                    u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+                    u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+                    u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+                }
+                // u[j] and u[j + 4] hold column j in their low halves and column j + 4 in the high
+                __m256i* out = static_cast<__m256i*>(v);
+                for (int j = 0; j < 4; ++j) {
+                    _mm256_storeu_si256(out + j, _mm256_permute2x128_si256(u[j], u[j + 4], 0x20));
+                    _mm256_storeu_si256(out + j + 4, _mm256_permute2x128_si256(u[j], u[j + 4], 0x31));
+                }
+            }
+        };
+
+        /// @brief 8 64-bit keys per AVX-512 register.
+        template<bool Signed>
+        struct avx512_keys64 {
+            using vector = __m512i;
+
+            __attribute__((target("avx512f"))) void load(vector& v, const void* p) const {
+                v = _mm512_loadu_si512(p);
+            }
+
+            __attribute__((target("avx512f"))) void store(void* p, const vector& v) const {
+                _mm512_storeu_si512(p, v);
+            }
+
+            __attribute__((target("avx512f"))) void compare_exchange(vector& a, vector& b) const {
+                const __m512i low = Signed ? _mm512_min_epi64(a, b) : _mm512_min_epu64(a, b);
+                b = Signed ? _mm512_max_epi64(a, b) : _mm512_max_epu64(a, b);
+                a = low;
+            }
+
+            __attribute__((target("avx512f"))) void bitonic_clean(vector& x) const {
+                __m512i t = _mm512_shuffle_i64x2(x, x, 0x4E);
+                compare_exchange(x, t);
+                x = _mm512_mask_blend_epi64(0xF0, x, t);
+                t = _mm512_permutex_epi64(x, 0x4E);
+                compare_exchange(x, t);
+                x = _mm512_mask_blend_epi64(0xCC, x, t);
+                t = _mm512_permutex_epi64(x, 0xB1);
+                compare_exchange(x, t);
+                x = _mm512_mask_blend_epi64(0xAA, x, t);
+            }
+
+            __attribute__((target("avx512f"))) void merge(vector& a, vector& b) const {
+                b = _mm512_permutexvar_epi64(_mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7), b);
+                compare_exchange(a, b);
+                bitonic_clean(a);
+                bitonic_clean(b);
+            }
+
+            __attribute__((target("avx512f"))) void transpose_store(void* v, const vector* r) const {
+                // t[i] / t[i + 1] pair rows i and i + 1 in the even / odd columns of each 128-bit lane
+                __m512i t[8];
+                for (int i = 0; i < 8; i += 2) {
+                    t[i] = _mm512_unpacklo_epi64(r[i], r[i + 1]);
+                    t[i + 1] = _mm512_unpackhi_epi64(r[i], r[i + 1]);
+                }
+                __m512i* out = static_cast<__m512i*>(v);
+                for (int odd = 0; odd < 2; ++odd) {
+                    // Columns 0 and 4 (or 1 and 5) from lanes 0 and 2, columns 2 and 6 from lanes 1 and 3
+                    const __m512i low_rows_a = _mm512_shuffle_i64x2(t[odd], t[2 + odd], 0x88);
+                    const __m512i high_rows_a = _mm512_shuffle_i64x2(t[4 + odd], t[6 + odd], 0x88);
+                    const __m512i low_rows_b = _mm512_shuffle_i64x2(t[odd], t[2 + odd], 0xDD);
+                    const __m512i high_rows_b = _mm512_shuffle_i64x2(t[4 + odd], t[6 + odd], 0xDD);
+                    _mm512_storeu_si512(out + odd, _mm512_shuffle_i64x2(low_rows_a, high_rows_a, 0x88));
+                    _mm512_storeu_si512(out + 4 + odd, _mm512_shuffle_i64x2(low_rows_a, high_rows_a, 0xDD));
+                    _mm512_storeu_si512(out + 2 + odd, _mm512_shuffle_i64x2(low_rows_b, high_rows_b, 0x88));
+                    _mm512_storeu_si512(out + 6 + odd, _mm512_shuffle_i64x2(low_rows_b, high_rows_b, 0xDD));
+                }
+            }
+        };
+
+        /// @brief Merges two sorted runs whose lengths are multiples of 8, eight keys a step:
+        ///        the register of 8 largest keys is merged next with 8 keys from the run whose
+        ///        next key is smaller.
+        template<typename T, typename Ops>
+        __attribute__((always_inline)) inline void merge_runs_simd(const T* a, const T* a_end, const T* b,
+                                                                   const T* b_end, T* out, Ops ops) {
+            if (a == a_end || b == b_end) {
+                std::copy(b, b_end, std::copy(a, a_end, out));
+                return;
+            }
+            typename Ops::vector low;
+            typename Ops::vector high;
+            ops.load(low, a);
+            ops.load(high, b);
+            a += 8;
+            b += 8;
+            for (;;) {
+                ops.merge(low, high);
+                ops.store(out, low);
+                out += 8;
+                if (a == a_end && b == b_end) break;
+                const bool take_b = a == a_end || (b != b_end && *b < *a);
+                ops.load(low, take_b ? b : a);
+                b += take_b ? 8 : 0;
+                a += take_b ? 0 : 8;
+            }
+            ops.store(out, high);
+        }
+
+        /// @brief The network sort on SIMD registers, for n keys padded to a multiple of 8.
+        template<typename T, typename Ops>
+        __attribute__((always_inline)) inline void network_sort_simd(T* keys, size_t n, Ops ops) {
+            size_t i = 0;
+            for (; i + 64 <= n; i += 64) {
+                typename Ops::vector r[8];
+                for (int row = 0; row < 8; ++row) {
+                    ops.load(r[row], keys + i + 8 * row);
+                }
+                network8(r, ops);
+                ops.transpose_store(keys + i, r);
+            }
+            sort_blocks(keys + i, n - i);
+
+            T buffer[radix_sort_threshold];
+            T* source = keys;
+            T* target = buffer;
+            for (size_t width = 8; width < n; width *= 2) {
+                for (size_t lo = 0; lo < n; lo += 2 * width) {
+                    size_t mid = std::min(lo + width, n);
+                    size_t hi = std::min(lo + 2 * width, n);
+                    merge_runs_simd(source + lo, source + mid, source + mid, source + hi, target + lo, ops);
+                }
+                std::swap(source, target);
+            }
+            if (source != keys) {
+                std::copy(source, source + n, keys);
+            }
+        }
+
+        template<typename T>
+        __attribute__((target("avx2"))) void network_sort_avx2(T* keys, size_t n) {
+            network_sort_simd(keys, n, avx2_keys32<std::is_signed<T>::value>());
+        }
+
+        template<typename T>
+        __attribute__((target("avx512f"))) void network_sort_avx512(T* keys, size_t n) {
+            network_sort_simd(keys, n, avx512_keys64<std::is_signed<T>::value>());
+        }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+        /// @brief Copies the keys into a buffer padded to a multiple of 8 with the largest key,
+        ///        which sorts to the end, and sorts it on the widest registers the kernel has.
+        /// @return false if the kernel has no registers for this key width.
+        template<typename T>
+        bool network_sort_padded(T* first, T* last, sort_kernel kernel) {
+            const bool avx2 = sizeof(T) == 4 && kernel != sort_kernel::scalar;
+            const bool avx512 = sizeof(T) == 8 && kernel == sort_kernel::avx512;
+            if (!avx2 && !avx512) return false;
+
+            const size_t n = static_cast<size_t>(last - first);
+            const size_t padded = (n + 7) / 8 * 8;
+            T keys[radix_sort_threshold];
+            std::copy(first, last, keys);
+            std::fill(keys + n, keys + padded, std::numeric_limits<T>::max());
+            if (avx2) {
+                network_sort_avx2(keys, padded);
+            } else {
+                network_sort_avx512(keys, padded);
+            }
+            std::copy(keys, keys + n, first);
+            return true;
+        }
+#endif
+
+        /// @brief The network sort itself, for integer keys.
+        template<typename T>
+        void network_sort_keys(T* first, T* last, sort_kernel kernel) {
+            const size_t n = static_cast<size_t>(last - first);
+#if defined(CONTAINER_HAS_SIMD_SORT)
+            if (n > 8 && network_sort_padded(first, last, kernel)) return;
+#else
+            (void)kernel;
+#endif
+            size_t full = n - n % 8;
+            sort_blocks(first, full);
+            insertion_sort(first + full, last);
+            if (n <= 8) return;
+
+            T buffer[radix_sort_threshold];
+            T* source = first;
+            T* target = buffer;
+            for (size_t width = 8; width < n; width *= 2) {
+                for (size_t lo = 0; lo < n; lo += 2 * width) {
+                    size_t mid = std::min(lo + width, n);
+                    size_t hi = std::min(lo + 2 * width, n);
+                    merge_runs(source + lo, source + mid, source + mid, source + hi, target + lo);
+                }
+                std::swap(source, target);
+            }
+            if (source != first) {
+                std::copy(source, source + n, first);
+            }
+        }
+
+        template<typename T>
+        void network_sort_dispatch(T* first, T* last, sort_kernel kernel, std::false_type) {
+            network_sort_keys(first, last, kernel);
+        }
+
+        /// @brief Floating-point values are sorted as their radix keys, since compilers emit
+        ///        branches rather than conditional moves for a floating-point compare-exchange.
+        template<typename T>
+        void network_sort_dispatch(T* first, T* last, sort_kernel kernel, std::true_type) {
+            using Key = typename unsigned_bits<sizeof(T)>::type;
+            const size_t n = static_cast<size_t>(last - first);
+            Key keys[radix_sort_threshold];
+            for (size_t i = 0; i < n; ++i) {
+                keys[i] = radix_key(first[i]);
+            }
+            network_sort_keys(keys, keys + n, kernel);
+            for (size_t i = 0; i < n; ++i) {
+                first[i] = from_radix_key<T>(keys[i]);
+            }
+        }
+    } // namespace detail
+
+    /// @brief Sorts a small contiguous range of arithmetic values ascending.
+    /// @details Sorts blocks of 8 with a sorting network, then merges the blocks bottom-up
+    ///          through a stack buffer, so it never allocates. Ranges longer than
+    ///          radix_sort_threshold are rejected; sort_values() sends those to radix_sort().
+    ///          Every kernel gives the same result; one the CPU lacks falls back to the best
+    ///          it has.
+    /// @param first The beginning of the range.
+    /// @param last The end of the range.
+    /// @param kernel The instruction set to sort with, best_sort_kernel() by default.
+    template<typename T>
+    void network_sort(T* first, T* last, sort_kernel kernel = best_sort_kernel()) {
+        static_assert(radix_sortable<T>::value, "network_sort needs a fixed-width arithmetic type");
+        if (static_cast<size_t>(last - first) > radix_sort_threshold) {
+            throw std::length_error("network_sort range exceeds radix_sort_threshold");
+        }
+        if (last - first < 2) return;
+        kernel = std::min(kernel, best_sort_kernel());
+        detail::network_sort_dispatch(first, last, kernel, std::is_floating_point<T>());
+    }
+
+    /// @brief std::sort for element types without a radix key.
+    template<typename RandomIt>
+    void sort_values(RandomIt first, RandomIt last, std::false_type) {
+        std::sort(first, last);
+    }
+
+    /// @brief The radix kernel for arithmetic element types, the sorting network for small ranges.
+    template<typename RandomIt>
+    void sort_values(RandomIt first, RandomIt last, std::true_type) {
+        if (first == last) return;
+        if (static_cast<size_t>(last - first) < radix_sort_threshold) {
+            network_sort(&*first, &*first + (last - first));
+        } else {
+            radix_sort(&*first, &*first + (last - first));
+        }
+    }
+
+    /// @brief Sorts a range ascending, dispatching on radix_sortable at compile time.
+    /// @details Arithmetic ranges must be contiguous (std::vector, SmallVector, arrays).
+    template<typename RandomIt>
+    void sort_values(RandomIt first, RandomIt last) {
+        sort_values(first, last, radix_sortable<typename std::iterator_traits<RandomIt>::value_type>());
+    }
+} // namespace container
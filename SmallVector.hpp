@@ -0,0 +1,255 @@
+// meirshuker15@gmail.com
+//SmallVector.hpp
+//Description: A vector that keeps up to N elements inline and spills to the heap beyond that.
+//Used as the storage of MyContainer<T, InlineCapacity<N>>.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace container {
+
+    /// @brief Storage policy for MyContainer: keep up to N elements inside the object.
+    /// @details Pass it in place of the allocator, e.g. MyContainer<int, InlineCapacity<16>>.
+    /// @tparam N The number of elements stored without any heap allocation.
+    template<size_t N>
+    struct InlineCapacity {
+        static_assert(N > 0, "InlineCapacity needs room for at least one element");
+    };
+
+    /// @brief A std::vector-like sequence with inline storage for the first N elements.
+    /// @details Only the subset of the std::vector interface that MyContainer needs is provided.
+    ///          Iterators are plain pointers and are invalidated like std::vector's.
+    /// @tparam T The element type.
+    /// @tparam N The inline capacity.
+    template<typename T, size_t N>
+    class SmallVector {
+    public:
+        using value_type = T;
+        using allocator_type = std::allocator<T>;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    private:
+        alignas(T) unsigned char inline_buffer[N * sizeof(T)];
+        T* data_;
+        size_t size_ = 0;
+        size_t capacity_ = N;
+
+        T* inline_data() { return reinterpret_cast<T*>(inline_buffer); }
+        bool is_inline() const { return data_ == reinterpret_cast<const T*>(inline_buffer); }
+
+        /// @brief Moves the elements into a buffer of the given capacity (inline if it fits).
+        void relocate(size_t new_capacity) {
+            T* target = new_capacity <= N ? inline_data() : allocator_type().allocate(new_capacity);
+            if (target == data_) return;
+            for (size_t i = 0; i < size_; ++i) {
+                new (target + i) T(std::move(data_[i]));
+                data_[i].~T();
+            }
+            release_heap();
+            data_ = target;
+            capacity_ = new_capacity <= N ? N : new_capacity;
+        }
+
+        void release_heap() {
+            if (!is_inline()) {
+                allocator_type().deallocate(data_, capacity_);
+            }
+        }
+
+        void destroy_all() {
+            for (size_t i = 0; i < size_; ++i) {
+                data_[i].~T();
+            }
+            size_ = 0;
+        }
+
+        /// @brief Takes over another vector's elements, stealing its heap buffer if it has one.
+        void steal(SmallVector& other) {
+            if (other.is_inline()) {
+                for (size_t i = 0; i < other.size_; ++i) {
+                    new (data_ + i) T(std::move(other.data_[i]));
+                }
+                size_ = other.size_;
+                other.destroy_all();
+            } else {
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_data();
+                other.size_ = 0;
+                other.capacity_ = N;
+            }
+        }
+
+    public:
+        SmallVector() : data_(inline_data()) {}
+
+        /// @brief Constructs an empty vector; inline storage needs no allocator state.
+        explicit SmallVector(const allocator_type&) : data_(inline_data()) {}
+
+        SmallVector(const SmallVector& other) : data_(inline_data()) {
+            assign(other.begin(), other.end());
+        }
+
+        SmallVector(SmallVector&& other) noexcept : data_(inline_data()) {
+            steal(other);
+        }
+
+        SmallVector& operator=(const SmallVector& other) {
+            if (this != &other) {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        SmallVector& operator=(SmallVector&& other) noexcept {
+            if (this != &other) {
+                destroy_all();
+                release_heap();
+                data_ = inline_data();
+                capacity_ = N;
+                steal(other);
+            }
+            return *this;
+        }
+
+        ~SmallVector() {
+            destroy_all();
+            release_heap();
+        }
+
+        allocator_type get_allocator() const { return allocator_type(); }
+
+        /*===============================================
+        Element Access and Iterators
+        ===============================================*/
+
+        T& operator[](size_t i) { return data_[i]; }
+        const T& operator[](size_t i) const { return data_[i]; }
+        T& front() { return data_[0]; }
+        const T& front() const { return data_[0]; }
+        T& back() { return data_[size_ - 1]; }
+        const T& back() const { return data_[size_ - 1]; }
+        T* data() { return data_; }
+        const T* data() const { return data_; }
+
+        iterator begin() { return data_; }
+        iterator end() { return data_ + size_; }
+        const_iterator begin() const { return data_; }
+        const_iterator end() const { return data_ + size_; }
+        const_iterator cbegin() const { return data_; }
+        const_iterator cend() const { return data_ + size_; }
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+        const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+
+        /*===============================================
+        Capacity
+        ===============================================*/
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        size_t capacity() const { return capacity_; }
+
+        void reserve(size_t new_capacity) {
+            if (new_capacity > capacity_) {
+                relocate(new_capacity);
+            }
+        }
+
+        /// @brief Moves the elements back inline if they fit, otherwise trims the heap buffer.
+        void shrink_to_fit() {
+            if (!is_inline() && size_ < capacity_) {
+                relocate(size_);
+            }
+        }
+
+        /*===============================================
+        Modifiers
+        ===============================================*/
+
+        template<typename... Args>
+        void emplace_back(Args&&... args) {
+            if (size_ == capacity_) {
+                T value(std::forward<Args>(args)...); // args may refer to an element being moved
+                relocate(capacity_ * 2);
+                new (data_ + size_) T(std::move(value));
+            } else {
+                new (data_ + size_) T(std::forward<Args>(args)...);
+            }
+            ++size_;
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        void pop_back() {
+            --size_;
+            data_[size_].~T();
+        }
+
+        /// @brief Inserts a value before pos.
+        iterator insert(const_iterator pos, const T& value) {
+            size_t index = pos - data_;
+            emplace_back(value);
+            std::rotate(data_ + index, data_ + size_ - 1, data_ + size_);
+            return data_ + index;
+        }
+
+        /// @brief Inserts a range before pos.
+        template<typename InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last) {
+            size_t index = pos - data_;
+            size_t old_size = size_;
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            std::rotate(data_ + index, data_ + old_size, data_ + size_);
+            return data_ + index;
+        }
+
+        template<typename InputIt>
+        void assign(InputIt first, InputIt last) {
+            clear();
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            T* from = data_ + (first - data_);
+            T* to = data_ + (last - data_);
+            T* new_end = std::move(to, end(), from);
+            for (T* it = new_end; it != end(); ++it) {
+                it->~T();
+            }
+            size_ = new_end - data_;
+            return from;
+        }
+
+        void resize(size_t new_size) {
+            if (new_size < size_) {
+                erase(data_ + new_size, end());
+                return;
+            }
+            reserve(new_size);
+            while (size_ < new_size) {
+                new (data_ + size_) T();
+                ++size_;
+            }
+        }
+
+        void clear() { destroy_all(); }
+    };
+} // namespace container
@@ -0,0 +1,116 @@
+//SortBench.cpp
+// meirshuker15@gmail.com
+//Description: Standalone micro-benchmark of the small-range sorting kernels in RadixSort.hpp.
+//Sorts many short arrays of int32_t, int64_t, float and double with std::sort and with
+//network_sort() on each kernel, checks every result against std::sort and prints the time
+//per element. Build and run with `make sort-bench`; ./sort_bench --total=N sets how many
+//elements each measurement sorts (default 4000000). Kernels the CPU lacks are skipped.
+#include "RadixSort.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace container;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Elements sorted by each measurement, set by --total.
+    size_t total = 4000000;
+
+    /// @brief Set when any kernel's output differs from std::sort's.
+    bool mismatch = false;
+
+    const char* kernel_name(sort_kernel kernel) {
+        switch (kernel) {
+            case sort_kernel::avx2: return "avx2";
+            case sort_kernel::avx512: return "avx512";
+            default: return "scalar";
+        }
+    }
+
+    /// @brief Full-width pseudo-random values; floating-point ones span both signs.
+    template<typename T>
+    std::vector<T> random_values(size_t n) {
+        std::vector<T> values(n);
+        uint64_t state = 12345;
+        for (size_t i = 0; i < n; ++i) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const uint64_t bits = state >> 1;
+            if (std::is_floating_point<T>::value) {
+                values[i] = static_cast<T>(static_cast<int64_t>(bits) - (int64_t(1) << 62)) / T(7);
+            } else {
+                std::memcpy(&values[i], &bits, sizeof(T));
+            }
+        }
+        return values;
+    }
+
+    /// @brief Sorts every run of n with sort(first, last) and returns the nanoseconds per element.
+    template<typename T, typename Sort>
+    double time_runs(std::vector<T>& work, size_t n, Sort sort) {
+        const size_t rounds = work.size() / n;
+        const Clock::time_point start = Clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            sort(work.data() + r * n, work.data() + (r + 1) * n);
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        return seconds * 1e9 / static_cast<double>(rounds * n);
+    }
+
+    void print(const std::string& type, size_t n, const std::string& name, double ns, double baseline) {
+        std::cout << std::left << std::setw(10) << type << " n=" << std::setw(5) << n
+                  << std::setw(10) << name
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(8) << ns << " ns/elem"
+                  << std::setw(8) << baseline / ns << "x" << std::endl;
+    }
+
+    /// @brief Compares std::sort with network_sort() on every kernel up to the CPU's best.
+    template<typename T>
+    void compare_kernels(const std::string& type, size_t n) {
+        const std::vector<T> input = random_values<T>(total - total % n);
+        std::vector<T> expected = input;
+        const double comparison = time_runs(expected, n, [](T* first, T* last) { std::sort(first, last); });
+        print(type, n, "std::sort", comparison, comparison);
+
+        for (sort_kernel kernel : {sort_kernel::scalar, sort_kernel::avx2, sort_kernel::avx512}) {
+            if (kernel > best_sort_kernel()) break;
+            std::vector<T> work = input;
+            const double ns = time_runs(work, n, [kernel](T* first, T* last) { network_sort(first, last, kernel); });
+            print(type, n, kernel_name(kernel), ns, comparison);
+            if (work != expected) {
+                std::cout << "  MISMATCH: " << kernel_name(kernel) << " differs from std::sort" << std::endl;
+                mismatch = true;
+            }
+        }
+    }
+} // namespace
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "--total=", 8) == 0) {
+            total = static_cast<size_t>(std::atof(argv[i] + 8));
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--total=N]" << std::endl;
+            return 2;
+        }
+    }
+    if (total < radix_sort_threshold) total = radix_sort_threshold;
+
+    std::cout << "best kernel on this CPU: " << kernel_name(best_sort_kernel()) << std::endl;
+    for (size_t n : {8u, 16u, 64u, 128u, 255u}) {
+        compare_kernels<int32_t>("int32_t", n);
+        compare_kernels<int64_t>("int64_t", n);
+        compare_kernels<float>("float", n);
+        compare_kernels<double>("double", n);
+    }
+    return mismatch ? 1 : 0;
+}
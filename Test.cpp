@@ -5,14 +5,61 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.hpp"
 #include "MyContainer.hpp"
+#include "ArenaAllocator.hpp"
+#include "ConcurrentMyContainer.hpp"
 
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <sstream>
+#include <iterator>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <limits>
+#include <cmath>
+#include <cstring>
+#include <thread>
 
 using namespace container;
 
+// Counts global heap allocations so tests can check allocation-free paths
+static std::atomic<size_t> heap_allocations(0);
+
+void* operator new(std::size_t size) {
+    ++heap_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    ++heap_allocations;
+    return std::malloc(size ? size : 1);
+}
+
+// Once optimisation inlines these into their callers, GCC sees free() applied to a pointer
+// from operator new and warns, although both sides of the pair are the replacements above
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
 TEST_CASE("Integer Container") {
     MyContainer<int> container;
     
@@ -398,6 +445,18 @@ struct Person {
     }
 };
 
+struct PersonHash {
+    size_t operator()(const Person& p) const {
+        return std::hash<std::string>()(p.name) ^ std::hash<int>()(p.age);
+    }
+};
+
+// Sort Person containers through a position permutation instead of copying the payload
+namespace container {
+    template<>
+    struct index_snapshot<Person> : std::true_type {};
+}
+
 
 TEST_CASE("Custom Object Container") {
     MyContainer<Person> people;
@@ -420,6 +479,26 @@ TEST_CASE("Custom Object Container") {
         CHECK(actual == expected);
     }
 
+    SUBCASE("Index snapshot orders") {
+        static_assert(MyContainer<Person>::SortedView::by_index, "Person should use index snapshots");
+        std::vector<Person> expected_desc = {charlie, alice, bob};
+        std::vector<Person> actual_desc;
+        for(auto it = people.begin_descending_order(); it != people.end_sentinel(); ++it) {
+            actual_desc.push_back(*it);
+        }
+        CHECK(actual_desc == expected_desc);
+
+        std::vector<Person> expected_cross = {bob, charlie, alice};
+        std::vector<Person> actual_cross;
+        for(auto it = people.begin_side_cross_order(); it != people.end_side_cross_order(); ++it) {
+            actual_cross.push_back(*it);
+        }
+        CHECK(actual_cross == expected_cross);
+
+        // The iterator points straight into the container, no payload copy is made
+        CHECK(&*people.begin_ascending_order() == &*(++people.begin_order()));
+    }
+
     SUBCASE("Remove person") {
         people.remove(alice);
         CHECK(people.size() == 2);
@@ -476,3 +555,1533 @@ TEST_CASE("Const Container") {
     CHECK(const_container.begin_side_cross_order() != const_container.end_side_cross_order());
     CHECK(const_container.begin_middle_out_order() != const_container.end_middle_out_order());
 }
+
+TEST_CASE("Shared Sorted View") {
+    MyContainer<int> container;
+    container.add(3);
+    container.add(1);
+    container.add(2);
+
+    // All sorted iterators built from the same version share one sorted view
+    auto asc = container.begin_ascending_order();
+    auto desc = container.begin_descending_order();
+    auto cross = container.begin_side_cross_order();
+    CHECK(&*asc == &*cross);        // both point at the smallest element
+    ++desc; ++desc;
+    CHECK(&*asc == &*desc);         // last descending element is the smallest
+
+    // Modifying the container rebuilds the view, old iterators keep their snapshot
+    container.add(0);
+    auto fresh = container.begin_ascending_order();
+    CHECK(*fresh == 0);
+    CHECK(*asc == 1);
+    CHECK(&*fresh != &*asc);
+
+    container.remove(0);
+    std::vector<int> actual;
+    for (auto it = container.begin_descending_order(); it != container.end_descending_order(); ++it) {
+        actual.push_back(*it);
+    }
+    std::vector<int> expected = {3, 2, 1};
+    CHECK(actual == expected);
+}
+
+TEST_CASE("End Sentinel") {
+    MyContainer<int> container;
+    container.add(7);
+    container.add(15);
+    container.add(6);
+    container.add(1);
+    container.add(2);
+
+    std::vector<int> asc, desc, cross, mid;
+    for (auto it = container.begin_ascending_order(); it != container.end_sentinel(); ++it) { asc.push_back(*it); }
+    for (auto it = container.begin_descending_order(); it != container.end_sentinel(); ++it) { desc.push_back(*it); }
+    for (auto it = container.begin_side_cross_order(); it != container.end_sentinel(); ++it) { cross.push_back(*it); }
+    for (auto it = container.begin_middle_out_order(); it != container.end_sentinel(); ++it) { mid.push_back(*it); }
+
+    CHECK(asc == std::vector<int>({1, 2, 6, 7, 15}));
+    CHECK(desc == std::vector<int>({15, 7, 6, 2, 1}));
+    CHECK(cross == std::vector<int>({1, 15, 2, 7, 6}));
+    CHECK(mid == std::vector<int>({6, 15, 1, 7, 2}));
+
+    // The sentinel agrees with the classic end iterators, in both argument orders
+    auto it = container.end_ascending_order();
+    CHECK(it == container.end_sentinel());
+    CHECK(container.end_sentinel() == container.end_middle_out_order());
+    CHECK(container.begin_side_cross_order() != container.end_sentinel());
+
+    MyContainer<int> empty;
+    CHECK(empty.begin_ascending_order() == empty.end_sentinel());
+    CHECK(empty.begin_descending_order() == empty.end_sentinel());
+    CHECK(empty.begin_side_cross_order() == empty.end_sentinel());
+    CHECK(empty.begin_middle_out_order() == empty.end_sentinel());
+}
+
+TEST_CASE("Iterator Copies Share Their Snapshot") {
+    MyContainer<int> container;
+    container.add(4);
+    container.add(9);
+    container.add(1);
+    container.add(7);
+
+    // Postfix increment and copies refer to the same underlying snapshot
+    auto asc = container.begin_ascending_order();
+    auto asc_old = asc++;
+    CHECK(*asc_old == 1);
+    CHECK(*asc == 4);
+    CHECK(&*asc_old + 1 == &*asc);
+
+    auto mid = container.begin_middle_out_order();
+    auto mid_old = mid++;
+    CHECK(*mid_old == 9);
+    CHECK(*mid == 4);
+
+    auto cross = container.begin_side_cross_order();
+    auto cross_old = cross++;
+    CHECK(*cross_old == 1);
+    CHECK(*cross == 9);
+
+    auto desc = container.begin_descending_order();
+    auto desc_old = desc++;
+    CHECK(*desc_old == 9);
+    CHECK(*desc == 7);
+
+    // Iterators are assignable, so they can be stored and reset
+    mid = container.begin_middle_out_order();
+    CHECK(*mid == 9);
+    cross = cross_old;
+    CHECK(*cross == 1);
+}
+
+TEST_CASE("Random Access Iterators") {
+    MyContainer<int> container;
+    container.add(7);
+    container.add(15);
+    container.add(6);
+    container.add(1);
+    container.add(2);
+
+    static_assert(std::is_same<std::iterator_traits<MyContainer<int>::Order>::iterator_category, std::random_access_iterator_tag>::value, "Order");
+    static_assert(std::is_same<std::iterator_traits<MyContainer<int>::ReverseOrder>::iterator_category, std::random_access_iterator_tag>::value, "ReverseOrder");
+    static_assert(std::is_same<std::iterator_traits<MyContainer<int>::AscendingOrder>::iterator_category, std::random_access_iterator_tag>::value, "AscendingOrder");
+    static_assert(std::is_same<std::iterator_traits<MyContainer<int>::DescendingOrder>::iterator_category, std::random_access_iterator_tag>::value, "DescendingOrder");
+    static_assert(std::is_same<std::iterator_traits<MyContainer<int>::SideCrossOrder>::iterator_category, std::random_access_iterator_tag>::value, "SideCrossOrder");
+    static_assert(std::is_same<std::iterator_traits<MyContainer<int>::MiddleOutOrder>::iterator_category, std::random_access_iterator_tag>::value, "MiddleOutOrder");
+
+    SUBCASE("Distance and indexing") {
+        CHECK(std::distance(container.begin_order(), container.end_order()) == 5);
+        CHECK(std::distance(container.begin_reverse_order(), container.end_reverse_order()) == 5);
+        CHECK(container.end_ascending_order() - container.begin_ascending_order() == 5);
+        CHECK(container.end_descending_order() - container.begin_descending_order() == 5);
+        CHECK(container.end_side_cross_order() - container.begin_side_cross_order() == 5);
+        CHECK(container.end_middle_out_order() - container.begin_middle_out_order() == 5);
+
+        CHECK(container.begin_order()[2] == 6);
+        CHECK(container.begin_reverse_order()[1] == 1);
+        CHECK(container.begin_ascending_order()[3] == 7);
+        CHECK(container.begin_descending_order()[4] == 1);
+        CHECK(container.begin_middle_out_order()[3] == 7);
+    }
+
+    SUBCASE("Jumping matches stepping") {
+        std::vector<int> stepped;
+        for (auto it = container.begin_side_cross_order(); it != container.end_sentinel(); ++it) {
+            stepped.push_back(*it);
+        }
+        auto begin = container.begin_side_cross_order();
+        for (int k = 0; k < 5; ++k) {
+            CHECK(*(begin + k) == stepped[k]);
+            CHECK(begin[k] == stepped[k]);
+        }
+        auto last = container.end_side_cross_order() - 1;
+        CHECK(*last == 6);
+        --last;
+        CHECK(*last == 7);
+        last -= 2;
+        CHECK(*last == 15);
+        CHECK(last == begin + 1);
+    }
+
+    SUBCASE("Ordering and standard algorithms") {
+        auto b = container.begin_ascending_order();
+        auto e = container.end_ascending_order();
+        CHECK(b < e);
+        CHECK(e > b);
+        CHECK(b <= b);
+        CHECK(e >= b + 5);
+
+        auto found = std::lower_bound(b, e, 6);
+        CHECK(found - b == 2);
+        CHECK(*found == 6);
+        CHECK(std::binary_search(b, e, 15));
+        CHECK_FALSE(std::binary_search(b, e, 3));
+
+        auto d = container.begin_descending_order();
+        auto firstSmall = std::lower_bound(d, container.end_descending_order(), 6, std::greater<int>());
+        CHECK(*firstSmall == 6);
+
+        auto m = container.begin_middle_out_order();
+        std::advance(m, 4);
+        CHECK(*m == 2);
+        CHECK((m + 1) == container.end_sentinel());
+    }
+}
+
+TEST_CASE("Middle Out Closed Form") {
+    // Compare against the table-building definition for a range of sizes
+    for (int n = 0; n <= 9; ++n) {
+        MyContainer<int> container;
+        for (int i = 0; i < n; ++i) {
+            container.add(i);
+        }
+
+        std::vector<int> expected;
+        if (n > 0) {
+            size_t mid = (n - 1) / 2;
+            expected.push_back(static_cast<int>(mid));
+            size_t l = mid - 1;
+            size_t r = mid + 1;
+            while (expected.size() < static_cast<size_t>(n)) {
+                if (l < static_cast<size_t>(n)) expected.push_back(static_cast<int>(l--));
+                if (r < static_cast<size_t>(n)) expected.push_back(static_cast<int>(r++));
+            }
+        }
+
+        std::vector<int> actual;
+        for (auto it = container.begin_middle_out_order(); it != container.end_middle_out_order(); ++it) {
+            actual.push_back(*it);
+        }
+        CHECK(actual == expected);
+
+        auto begin = container.begin_middle_out_order();
+        for (int k = 0; k < n; ++k) {
+            CHECK(begin[k] == expected[k]);
+        }
+    }
+}
+
+TEST_CASE("Side Cross Closed Form") {
+    MyContainer<int> container;
+    for (int v : {40, 10, 30, 20, 50, 60}) {
+        container.add(v);
+    }
+    // Sorted: 10 20 30 40 50 60
+    std::vector<int> expected = {10, 60, 20, 50, 30, 40};
+
+    auto begin = container.begin_side_cross_order();
+    auto asc = container.begin_ascending_order();
+    for (int k = 0; k < 6; ++k) {
+        CHECK(begin[k] == expected[k]);
+    }
+    // Side-cross reads the same sorted view as the ascending order
+    CHECK(&begin[0] == &asc[0]);
+    CHECK(&begin[1] == &asc[5]);
+    CHECK(&begin[5] == &asc[3]);
+
+    // Walking backwards from the end yields the reverse sequence
+    std::vector<int> backwards;
+    for (auto it = container.end_side_cross_order(); it != begin; ) {
+        --it;
+        backwards.push_back(*it);
+    }
+    std::reverse(backwards.begin(), backwards.end());
+    CHECK(backwards == expected);
+}
+
+TEST_CASE("Incrementally Maintained Sorted Index") {
+    SUBCASE("Value snapshots") {
+        MyContainer<int> container;
+        container.maintain_sorted_index();
+        container.add(5);
+        container.add(1);
+        container.add(9);
+        auto before = container.begin_ascending_order(); // builds the view
+
+        container.add(3);
+        container.add(5);
+        container.add(0);
+        container.remove(9);
+
+        std::vector<int> actual;
+        for (auto it = container.begin_ascending_order(); it != container.end_sentinel(); ++it) {
+            actual.push_back(*it);
+        }
+        CHECK(actual == std::vector<int>({0, 1, 3, 5, 5}));
+
+        std::vector<int> cross;
+        for (auto it = container.begin_side_cross_order(); it != container.end_sentinel(); ++it) {
+            cross.push_back(*it);
+        }
+        CHECK(cross == std::vector<int>({0, 5, 1, 5, 3}));
+
+        // The iterator taken before the updates still sees its own snapshot
+        CHECK(before[0] == 1);
+        CHECK(before[2] == 9);
+        CHECK(container.end_ascending_order() - container.begin_ascending_order() == 5);
+    }
+
+    SUBCASE("Index snapshots") {
+        MyContainer<Person> people;
+        people.maintain_sorted_index();
+        Person a{"A", 40}, b{"B", 20}, c{"C", 30}, d{"D", 20}, e{"E", 10};
+        people.add(a);
+        people.add(b);
+        people.add(c);
+        CHECK(*people.begin_ascending_order() == b);
+
+        people.add(d);
+        people.add(e);
+        people.remove(b);
+        people.remove(a);
+
+        std::vector<Person> actual;
+        for (auto it = people.begin_ascending_order(); it != people.end_sentinel(); ++it) {
+            actual.push_back(*it);
+        }
+        CHECK(actual == std::vector<Person>({e, d, c}));
+    }
+}
+
+TEST_CASE("Hash Indexed Remove") {
+    MyContainer<int> container;
+    for (int v : {4, 8, 4, 15, 16, 23, 42, 8}) {
+        container.add(v);
+    }
+    container.enable_hash_index();
+
+    container.remove(8);
+    container.remove(42);
+    CHECK(container.size() == 5);
+    CHECK_THROWS_AS(container.remove(8), std::invalid_argument);
+    CHECK_THROWS_AS(container.remove(99), std::invalid_argument);
+
+    container.add(8);
+    container.remove(4);
+    CHECK(container.size() == 4);
+
+    // Reads see the compacted elements in insertion order
+    std::vector<int> order(container.begin_order(), container.end_order());
+    CHECK(order == std::vector<int>({15, 16, 23, 8}));
+
+    std::vector<int> asc(container.begin_ascending_order(), container.end_ascending_order());
+    CHECK(asc == std::vector<int>({8, 15, 16, 23}));
+
+    // The index keeps working after compaction and on copies
+    MyContainer<int> copy = container;
+    container.remove(16);
+    CHECK(container.size() == 3);
+    CHECK(copy.size() == 4);
+    copy.remove(15);
+    std::vector<int> copy_order(copy.begin_order(), copy.end_order());
+    CHECK(copy_order == std::vector<int>({16, 23, 8}));
+
+    container.disable_hash_index();
+    container.remove(23);
+    std::ostringstream oss;
+    oss << container;
+    CHECK(oss.str() == "[15, 8]");
+
+    SUBCASE("Together with a maintained index snapshot") {
+        MyContainer<Person> people;
+        Person a{"A", 40}, b{"B", 20}, c{"C", 30};
+        people.add(a);
+        people.add(b);
+        people.add(c);
+        people.maintain_sorted_index();
+        people.enable_hash_index<PersonHash>();
+        CHECK(*people.begin_ascending_order() == b);
+
+        people.remove(b);
+        people.add(Person{"D", 10});
+        people.remove(a);
+        std::vector<Person> actual(people.begin_ascending_order(), people.end_ascending_order());
+        CHECK(actual == std::vector<Person>({Person{"D", 10}, c}));
+    }
+
+    SUBCASE("A moved-from container is empty with no pending removals") {
+        MyContainer<int> source;
+        for (int v : {1, 2, 3, 4, 3}) {
+            source.add(v);
+        }
+        source.enable_hash_index();
+        source.remove(3);
+        auto kept = source.reversed();
+        MyContainer<int> moved = std::move(source);
+        CHECK(source.size() == 0);
+        CHECK(source.begin_order() == source.end_order());
+        CHECK(source.begin_ascending_order() == source.end_ascending_order());
+        CHECK(kept.empty());
+        source.add(7);
+        CHECK(std::vector<int>(source.begin_order(), source.end_order()) == std::vector<int>({7}));
+        CHECK(std::vector<int>(moved.begin_order(), moved.end_order()) == std::vector<int>({1, 2, 4}));
+        moved.remove(2);
+        CHECK(moved.size() == 2);
+
+        MyContainer<int> target;
+        target.add(9);
+        moved.remove(4);
+        target = std::move(moved);
+        CHECK(moved.size() == 0);
+        CHECK(moved.begin_order() == moved.end_order());
+        CHECK(std::vector<int>(target.begin_order(), target.end_order()) == std::vector<int>({1}));
+        target.remove(1);
+        CHECK(target.size() == 0);
+    }
+}
+
+TEST_CASE("Non-Throwing and Batch Removal") {
+    MyContainer<int> container;
+    for (int v : {3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5}) {
+        container.add(v);
+    }
+
+    SUBCASE("try_remove") {
+        CHECK(container.try_remove(5) == 3);
+        CHECK(container.try_remove(5) == 0);
+        CHECK(container.try_remove(42) == 0);
+        CHECK(container.size() == 8);
+    }
+
+    SUBCASE("remove_if") {
+        CHECK(container.remove_if([](int v) { return v % 2 == 1; }) == 8);
+        std::vector<int> order(container.begin_order(), container.end_order());
+        CHECK(order == std::vector<int>({4, 2, 6}));
+        CHECK(container.remove_if([](int v) { return v > 100; }) == 0);
+    }
+
+    SUBCASE("erase_many") {
+        std::vector<int> batch = {1, 9, 7, 1};
+        CHECK(container.erase_many(batch.begin(), batch.end()) == 3);
+        CHECK(container.erase_many(batch) == 0);
+        CHECK(container.erase_many({3, 6}) == 3);
+        std::vector<int> order(container.begin_order(), container.end_order());
+        CHECK(order == std::vector<int>({4, 5, 2, 5, 5}));
+    }
+
+    SUBCASE("Batch removal keeps a maintained view and hash index in sync") {
+        container.maintain_sorted_index();
+        container.begin_ascending_order();
+        CHECK(container.erase_many({1, 5}) == 5);
+        container.enable_hash_index();
+        CHECK(container.remove_if([](int v) { return v == 9; }) == 1);
+        CHECK(container.try_remove(3) == 2);
+        CHECK(container.erase_many({4, 8}) == 1);
+        std::vector<int> asc(container.begin_ascending_order(), container.end_ascending_order());
+        CHECK(asc == std::vector<int>({2, 6}));
+        std::vector<int> order(container.begin_order(), container.end_order());
+        CHECK(order == std::vector<int>({2, 6}));
+    }
+
+    SUBCASE("Index snapshots") {
+        MyContainer<Person> people;
+        people.maintain_sorted_index();
+        people.add(Person{"A", 30});
+        people.add(Person{"B", 20});
+        people.add(Person{"C", 30});
+        people.begin_ascending_order();
+        CHECK(people.erase_many({Person{"C", 30}, Person{"Z", 30}}) == 1);
+        std::vector<Person> asc(people.begin_ascending_order(), people.end_ascending_order());
+        CHECK(asc == std::vector<Person>({Person{"B", 20}, Person{"A", 30}}));
+    }
+}
+
+// Counts copies and moves to check that insertion does not copy more than needed
+struct Tracked {
+    static int copies;
+    static int moves;
+    int value;
+
+    Tracked(int v) : value(v) {}
+    Tracked(const Tracked& other) : value(other.value) { ++copies; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++moves; }
+    Tracked& operator=(const Tracked& other) { value = other.value; ++copies; return *this; }
+    Tracked& operator=(Tracked&& other) noexcept { value = other.value; ++moves; return *this; }
+
+    bool operator==(const Tracked& other) const { return value == other.value; }
+    bool operator<(const Tracked& other) const { return value < other.value; }
+};
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+TEST_CASE("Move-Aware and Emplacing Insertion") {
+    MyContainer<Tracked> container;
+    Tracked::copies = 0;
+
+    Tracked lvalue(4);
+    container.add(lvalue);          // one copy
+    CHECK(Tracked::copies == 1);
+
+    container.add(Tracked(2));      // moved, never copied
+    container.emplace(3);           // constructed in place
+    CHECK(Tracked::copies == 1);
+
+    std::vector<int> seed = {9, 1, 5};
+    container.add_range(seed.begin(), seed.end());
+    CHECK(Tracked::copies == 1);
+    CHECK(container.size() == 6);
+
+    std::vector<int> asc;
+    for (auto it = container.begin_ascending_order(); it != container.end_sentinel(); ++it) {
+        asc.push_back(it->value);
+    }
+    CHECK(asc == std::vector<int>({1, 2, 3, 4, 5, 9}));
+
+    SUBCASE("Strings") {
+        MyContainer<std::string> strings;
+        std::string key = "alpha";
+        strings.add(std::move(key));
+        strings.emplace(3, 'z');
+        std::vector<std::string> more = {"beta", "gamma"};
+        strings.add_range(more.begin(), more.end());
+        std::vector<std::string> order(strings.begin_order(), strings.end_order());
+        CHECK(order == std::vector<std::string>({"alpha", "zzz", "beta", "gamma"}));
+    }
+
+    SUBCASE("Bulk insert into a maintained sorted view") {
+        MyContainer<int> numbers;
+        numbers.maintain_sorted_index();
+        numbers.add(50);
+        numbers.add(10);
+        numbers.begin_ascending_order();
+        std::vector<int> batch = {40, 5, 30, 10};
+        numbers.add_range(batch.begin(), batch.end());
+        std::istringstream input("25 60");
+        numbers.add_range(std::istream_iterator<int>(input), std::istream_iterator<int>());
+        std::vector<int> sorted(numbers.begin_ascending_order(), numbers.end_ascending_order());
+        CHECK(sorted == std::vector<int>({5, 10, 10, 25, 30, 40, 50, 60}));
+    }
+
+    SUBCASE("Appending a container to itself") {
+        MyContainer<std::string> strings;
+        strings.add("a long string that is not stored inline");
+        strings.add("b");
+        strings.shrink_to_fit();
+        strings.add_range(strings.begin(), strings.end());
+        strings.add_range(strings.begin_middle_out_order(), strings.end_middle_out_order());
+        strings.add_range(strings.begin_ascending_order(), strings.end_ascending_order());
+        CHECK(strings.size() == 16);
+        std::vector<std::string> order(strings.begin_order(), strings.begin_order() + 4);
+        CHECK(order == std::vector<std::string>({"a long string that is not stored inline", "b",
+                                                 "a long string that is not stored inline", "b"}));
+        CHECK(std::count(strings.begin(), strings.end(), "b") == 8);
+
+        MyContainer<int, InlineCapacity<4>> small;
+        for (int v : {3, 1, 2, 4}) {
+            small.add(v);
+        }
+        small.add_range(small.begin_reverse_order(), small.end_reverse_order());
+        std::vector<int> doubled(small.begin_order(), small.end_order());
+        CHECK(doubled == std::vector<int>({3, 1, 2, 4, 4, 2, 1, 3}));
+    }
+}
+
+TEST_CASE("Capacity Management") {
+    MyContainer<int> container(64);
+    CHECK(container.size() == 0);
+    CHECK(container.capacity() >= 64);
+
+    container.reserve(1000);
+    CHECK(container.capacity() >= 1000);
+    size_t reserved = container.capacity();
+    for (int i = 0; i < 1000; ++i) {
+        container.add(i);
+    }
+    CHECK(container.capacity() == reserved); // no reallocation
+
+    container.remove_if([](int v) { return v >= 10; });
+    container.shrink_to_fit();
+    CHECK(container.size() == 10);
+    CHECK(container.capacity() < reserved);
+
+    container.enable_hash_index();
+    container.remove(3);
+    container.shrink_to_fit(); // applies the pending removal first
+    CHECK(container.capacity() <= 10);
+    std::vector<int> order(container.begin_order(), container.end_order());
+    CHECK(order == std::vector<int>({0, 1, 2, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST_CASE("Arena Allocator") {
+    MonotonicArena arena(256);
+    {
+        MyContainer<int, ArenaAllocator<int>> container{ArenaAllocator<int>(arena)};
+        for (int v : {7, 15, 6, 1, 2}) {
+            container.add(v);
+        }
+        size_t blocks_before = arena.block_count();
+        CHECK(blocks_before >= 1);
+
+        std::vector<int> asc(container.begin_ascending_order(), container.end_ascending_order());
+        CHECK(asc == std::vector<int>({1, 2, 6, 7, 15}));
+        std::vector<int> cross(container.begin_side_cross_order(), container.end_side_cross_order());
+        CHECK(cross == std::vector<int>({1, 15, 2, 7, 6}));
+        std::vector<int> mid(container.begin_middle_out_order(), container.end_middle_out_order());
+        CHECK(mid == std::vector<int>({6, 15, 1, 7, 2}));
+
+        std::ostringstream oss;
+        oss << container;
+        CHECK(oss.str() == "[7, 15, 6, 1, 2]");
+    }
+    arena.reset();
+    CHECK(arena.block_count() == 1);
+    arena.release();
+    CHECK(arena.block_count() == 0);
+
+    // The default allocator draws from the calling thread's arena
+    MyContainer<std::string, ArenaAllocator<std::string>> strings;
+    strings.add("b");
+    strings.add("a");
+    CHECK(*strings.begin_ascending_order() == "a");
+    CHECK(MonotonicArena::thread_local_arena().block_count() >= 1);
+}
+
+TEST_CASE("Inline Storage") {
+    MyContainer<int, InlineCapacity<16>> container;
+    std::vector<int> asc, desc, cross, mid, order, rev;
+    asc.reserve(64); desc.reserve(64); cross.reserve(64); mid.reserve(64); order.reserve(64); rev.reserve(64);
+
+    size_t before = heap_allocations;
+    for (int v : {7, 15, 6, 1, 2}) {
+        container.add(v);
+    }
+    for (auto it = container.begin_ascending_order(); it != container.end_sentinel(); ++it) { asc.push_back(*it); }
+    for (auto it = container.begin_descending_order(); it != container.end_sentinel(); ++it) { desc.push_back(*it); }
+    for (auto it = container.begin_side_cross_order(); it != container.end_sentinel(); ++it) { cross.push_back(*it); }
+    for (auto it = container.begin_middle_out_order(); it != container.end_sentinel(); ++it) { mid.push_back(*it); }
+    for (auto it = container.begin_order(); it != container.end_order(); ++it) { order.push_back(*it); }
+    for (auto it = container.begin_reverse_order(); it != container.end_reverse_order(); ++it) { rev.push_back(*it); }
+    auto copy = container.begin_ascending_order();
+    copy++;
+    container.remove(6);
+    size_t after = heap_allocations;
+
+    CHECK(after == before); // nothing above touched the heap
+    CHECK(asc == std::vector<int>({1, 2, 6, 7, 15}));
+    CHECK(desc == std::vector<int>({15, 7, 6, 2, 1}));
+    CHECK(cross == std::vector<int>({1, 15, 2, 7, 6}));
+    CHECK(mid == std::vector<int>({6, 15, 1, 7, 2}));
+    CHECK(order == std::vector<int>({7, 15, 6, 1, 2}));
+    CHECK(rev == std::vector<int>({2, 1, 6, 15, 7}));
+    CHECK(*copy == 2);
+    CHECK(container.capacity() == 16);
+
+    SUBCASE("Spilling to the heap and back") {
+        for (int i = 100; i < 120; ++i) {
+            container.add(i);
+        }
+        CHECK(container.size() == 24);
+        CHECK(container.capacity() > 16);
+        auto snapshot = container.begin_ascending_order();
+        std::vector<int> sorted(container.begin_ascending_order(), container.end_ascending_order());
+        CHECK(sorted.size() == 24);
+        CHECK(std::is_sorted(sorted.begin(), sorted.end()));
+
+        container.remove_if([](int v) { return v >= 100; });
+        container.shrink_to_fit();
+        CHECK(container.capacity() == 16);
+        std::vector<int> back(container.begin_order(), container.end_order());
+        CHECK(back == std::vector<int>({7, 15, 1, 2}));
+        CHECK(snapshot[23] == 119); // the old snapshot is untouched
+
+        MyContainer<int, InlineCapacity<16>> copied = container;
+        std::ostringstream oss;
+        oss << copied;
+        CHECK(oss.str() == "[7, 15, 1, 2]");
+    }
+
+    SUBCASE("Maintained view and strings") {
+        container.maintain_sorted_index();
+        container.begin_ascending_order();
+        container.add(0);
+        CHECK(*container.begin_ascending_order() == 0);
+
+        MyContainer<std::string, InlineCapacity<4>> words;
+        words.add("pear");
+        words.add("apple");
+        words.emplace("fig");
+        std::vector<std::string> sorted_words(words.begin_ascending_order(), words.end_ascending_order());
+        CHECK(sorted_words == std::vector<std::string>({"apple", "fig", "pear"}));
+    }
+}
+
+TEST_CASE("Radix Sort") {
+    static_assert(radix_sortable<int>::value, "int keys are radix-sorted");
+    static_assert(radix_sortable<double>::value, "double keys are radix-sorted");
+    static_assert(!radix_sortable<bool>::value, "bool keeps std::sort");
+    static_assert(!radix_sortable<long double>::value, "long double keeps std::sort");
+    static_assert(!radix_sortable<std::string>::value, "strings keep std::sort");
+
+    const size_t n = 5000; // well above radix_sort_threshold
+    unsigned state = 7;
+    auto next = [&state]() { state = state * 1103515245u + 12345u; return state; };
+
+    SUBCASE("Signed integers") {
+        MyContainer<int> container;
+        std::vector<int> expected;
+        for (size_t i = 0; i < n; ++i) {
+            int v = static_cast<int>(next()) % 100000; // mixed signs, many duplicates
+            container.add(v);
+            expected.push_back(v);
+        }
+        container.add(std::numeric_limits<int>::min());
+        container.add(std::numeric_limits<int>::max());
+        expected.push_back(std::numeric_limits<int>::min());
+        expected.push_back(std::numeric_limits<int>::max());
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<int> asc(container.begin_ascending_order(), container.end_ascending_order());
+        std::vector<int> desc(container.begin_descending_order(), container.end_descending_order());
+        CHECK(asc == expected);
+        CHECK(std::equal(desc.begin(), desc.end(), expected.rbegin()));
+        CHECK(*container.begin_side_cross_order() == std::numeric_limits<int>::min());
+        CHECK(container.begin_side_cross_order()[1] == std::numeric_limits<int>::max());
+    }
+
+    SUBCASE("Floating point") {
+        MyContainer<double> container;
+        std::vector<double> expected;
+        for (size_t i = 0; i < n; ++i) {
+            double v = (static_cast<int>(next() >> 8) % 20001 - 10000) / 7.0;
+            container.add(v);
+            expected.push_back(v);
+        }
+        for (double v : {-std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+                         std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::max()}) {
+            container.add(v);
+            expected.push_back(v);
+        }
+        std::sort(expected.begin(), expected.end());
+        std::vector<double> asc(container.begin_ascending_order(), container.end_ascending_order());
+        CHECK(asc == expected);
+    }
+
+    SUBCASE("Narrow and unsigned keys") {
+        std::vector<signed char> bytes;
+        std::vector<uint64_t> wide;
+        for (size_t i = 0; i < n; ++i) {
+            bytes.push_back(static_cast<signed char>(next() >> 16));
+            wide.push_back((static_cast<uint64_t>(next()) << 32) | next());
+        }
+        std::vector<signed char> sorted_bytes = bytes;
+        std::vector<uint64_t> sorted_wide = wide;
+        radix_sort(bytes.data(), bytes.data() + bytes.size());
+        radix_sort(wide.data(), wide.data() + wide.size());
+        std::sort(sorted_bytes.begin(), sorted_bytes.end());
+        std::sort(sorted_wide.begin(), sorted_wide.end());
+        CHECK(bytes == sorted_bytes);
+        CHECK(wide == sorted_wide);
+    }
+
+    SUBCASE("Maintained view merges a radix-sorted tail") {
+        MyContainer<int> container;
+        container.maintain_sorted_index();
+        std::vector<int> values;
+        for (size_t i = 0; i < n; ++i) {
+            values.push_back(static_cast<int>(next()));
+        }
+        container.add_range(values.begin(), values.begin() + n / 2);
+        container.begin_ascending_order();
+        container.add_range(values.begin() + n / 2, values.end());
+        std::sort(values.begin(), values.end());
+        std::vector<int> asc(container.begin_ascending_order(), container.end_ascending_order());
+        CHECK(asc == values);
+    }
+}
+
+// Sorts random full-width values of every size below the radix threshold with one kernel
+// and reports whether each result equals std::sort's
+template<typename T>
+bool kernel_matches_std_sort(sort_kernel kernel) {
+    uint64_t state = 7;
+    bool matches = true;
+    for (size_t n = 0; n < radix_sort_threshold; ++n) {
+        std::vector<T> values;
+        for (size_t i = 0; i < n; ++i) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            uint64_t bits = (i % 3 == 0) ? state >> 60 : state >> 1; // some duplicates
+            T v;
+            if (std::is_floating_point<T>::value) {
+                v = static_cast<T>(static_cast<int64_t>(bits) - (int64_t(1) << 61)) / T(3);
+            } else {
+                std::memcpy(&v, &bits, sizeof(T));
+            }
+            values.push_back(v);
+        }
+        std::vector<T> expected = values;
+        std::sort(expected.begin(), expected.end());
+        network_sort(values.data(), values.data() + n, kernel);
+        matches = matches && values == expected;
+    }
+    return matches;
+}
+
+TEST_CASE("Small Range Sorting Network") {
+    SUBCASE("Every 0/1 input of 8 values (zero-one principle)") {
+        bool all_sorted = true;
+        for (unsigned mask = 0; mask < 256; ++mask) {
+            int v[8];
+            for (int i = 0; i < 8; ++i) {
+                v[i] = (mask >> i) & 1;
+            }
+            network_sort(v, v + 8);
+            all_sorted = all_sorted && std::is_sorted(v, v + 8);
+        }
+        CHECK(all_sorted);
+    }
+
+    SUBCASE("Matches std::sort for every size below the radix threshold") {
+        unsigned state = 11;
+        bool matches = true;
+        for (size_t n = 0; n < radix_sort_threshold; ++n) {
+            std::vector<int32_t> ints;
+            std::vector<int64_t> longs;
+            std::vector<float> floats;
+            std::vector<double> doubles;
+            for (size_t i = 0; i < n; ++i) {
+                state = state * 1103515245u + 12345u;
+                int32_t v = static_cast<int32_t>(state) % 50; // plenty of duplicates
+                ints.push_back(v);
+                longs.push_back(static_cast<int64_t>(v) * 4000000000LL);
+                floats.push_back(v / 3.0f);
+                doubles.push_back(-v / 7.0);
+            }
+            std::vector<int32_t> i2 = ints;
+            std::vector<int64_t> l2 = longs;
+            std::vector<float> f2 = floats;
+            std::vector<double> d2 = doubles;
+            sort_values(ints.begin(), ints.end());
+            sort_values(longs.begin(), longs.end());
+            sort_values(floats.begin(), floats.end());
+            sort_values(doubles.begin(), doubles.end());
+            std::sort(i2.begin(), i2.end());
+            std::sort(l2.begin(), l2.end());
+            std::sort(f2.begin(), f2.end());
+            std::sort(d2.begin(), d2.end());
+            matches = matches && ints == i2 && longs == l2 && floats == f2 && doubles == d2;
+        }
+        CHECK(matches);
+    }
+
+    SUBCASE("Every SIMD kernel matches std::sort") {
+        // Kernels this CPU lacks fall back to the best one it has
+        for (sort_kernel kernel : {sort_kernel::scalar, sort_kernel::avx2, sort_kernel::avx512}) {
+            CHECK(kernel_matches_std_sort<int32_t>(kernel));
+            CHECK(kernel_matches_std_sort<uint32_t>(kernel));
+            CHECK(kernel_matches_std_sort<int64_t>(kernel));
+            CHECK(kernel_matches_std_sort<uint64_t>(kernel));
+            CHECK(kernel_matches_std_sort<float>(kernel));
+            CHECK(kernel_matches_std_sort<double>(kernel));
+            CHECK(kernel_matches_std_sort<int16_t>(kernel));
+        }
+    }
+
+    SUBCASE("Floating-point values keep their exact bits") {
+        double v[] = {0.0, -0.0, 1.5, -0.0, 0.0, -1.5};
+        network_sort(v, v + 6);
+        CHECK(v[0] == -1.5);
+        CHECK((std::signbit(v[1]) && std::signbit(v[2])));
+        CHECK((!std::signbit(v[3]) && !std::signbit(v[4])));
+        CHECK(v[5] == 1.5);
+    }
+
+    SUBCASE("Oversized ranges are rejected") {
+        std::vector<int> big(radix_sort_threshold + 1);
+        CHECK_THROWS_AS(network_sort(big.data(), big.data() + big.size()), std::length_error);
+    }
+}
+
+TEST_CASE("Parallel Sorted Views") {
+    unsigned state = 3;
+    auto next = [&state]() { state = state * 1103515245u + 12345u; return state >> 4; };
+
+    SUBCASE("parallel_sort matches std::sort for any thread count") {
+        bool matches = true;
+        for (unsigned threads = 1; threads <= 9; ++threads) {
+            std::vector<std::string> words;
+            for (size_t i = 0; i < 3000 + threads; ++i) {
+                words.push_back(std::to_string(next() % 500)); // many duplicates
+            }
+            std::vector<std::string> expected = words;
+            std::sort(expected.begin(), expected.end());
+            auto less = [](const std::string& a, const std::string& b) { return a < b; };
+            parallel_sort(words.data(), words.data() + words.size(), less,
+                          [&less](std::string* first, std::string* last) { std::sort(first, last, less); },
+                          ParallelPolicy(threads, 100));
+            matches = matches && words == expected;
+        }
+        CHECK(matches);
+    }
+
+    SUBCASE("Policy overloads of the sorted iterators") {
+        ParallelPolicy four(4, 1000);
+        CHECK(four.thread_count() == 4);
+        CHECK(par.thread_count() >= 1);
+
+        MyContainer<int> ints;
+        std::vector<int> values;
+        for (size_t i = 0; i < 20000; ++i) {
+            int v = static_cast<int>(next()) - (1 << 27);
+            ints.add(v);
+            values.push_back(v);
+        }
+        std::sort(values.begin(), values.end());
+        std::vector<int> asc(ints.begin_ascending_order(four), ints.end_ascending_order());
+        CHECK(asc == values);
+        ints.add(std::numeric_limits<int>::max());
+        CHECK(*ints.begin_descending_order(four) == std::numeric_limits<int>::max());
+        ints.add(std::numeric_limits<int>::min());
+        auto cross = ints.begin_side_cross_order(four);
+        CHECK(cross[0] == std::numeric_limits<int>::min());
+        CHECK(cross[1] == std::numeric_limits<int>::max());
+        CHECK(cross[2] == values.front());
+
+        MyContainer<Person> people; // index snapshots sort positions in parallel
+        for (size_t i = 0; i < 5000; ++i) {
+            people.add(Person{"p" + std::to_string(i), static_cast<int>(next() % 90)});
+        }
+        std::vector<Person> by_age(people.begin_ascending_order(ParallelPolicy(3, 100)), people.end_ascending_order());
+        CHECK(by_age.size() == 5000);
+        CHECK(std::is_sorted(by_age.begin(), by_age.end()));
+    }
+
+    SUBCASE("Below the threshold the sort stays serial") {
+        MyContainer<int> small;
+        for (int v : {5, 3, 9, 1}) {
+            small.add(v);
+        }
+        std::vector<int> asc(small.begin_ascending_order(par), small.end_ascending_order());
+        CHECK(asc == std::vector<int>({1, 3, 5, 9}));
+    }
+}
+
+// Runs parallel_for_each over an order and returns the elements by position
+template<typename OrderTag>
+std::vector<int> collect_in_parallel(const MyContainer<int>& container, OrderTag order, unsigned threads,
+                                     size_t& visits) {
+    std::vector<int> seen(static_cast<size_t>(container.size()));
+    std::atomic<size_t> count(0);
+    container.parallel_for_each(order, [&seen, &count](size_t position, const int& value) {
+        seen[position] = value;
+        ++count;
+    }, threads);
+    visits = count;
+    return seen;
+}
+
+TEST_CASE("Parallel For Each") {
+    MyContainer<int> container;
+    for (int i = 0; i < 10007; ++i) {
+        container.add((i * 7919) % 10007 - 5000);
+    }
+    size_t visits = 0;
+
+    for (unsigned threads : {1u, 3u, 8u}) {
+        CHECK(collect_in_parallel(container, orders::insertion, threads, visits) ==
+              std::vector<int>(container.begin_order(), container.end_order()));
+        CHECK(visits == 10007);
+        CHECK(collect_in_parallel(container, orders::reverse, threads, visits) ==
+              std::vector<int>(container.begin_reverse_order(), container.end_reverse_order()));
+        CHECK(collect_in_parallel(container, orders::ascending, threads, visits) ==
+              std::vector<int>(container.begin_ascending_order(), container.end_ascending_order()));
+        CHECK(collect_in_parallel(container, orders::descending, threads, visits) ==
+              std::vector<int>(container.begin_descending_order(), container.end_descending_order()));
+        CHECK(collect_in_parallel(container, orders::side_cross, threads, visits) ==
+              std::vector<int>(container.begin_side_cross_order(), container.end_side_cross_order()));
+        CHECK(collect_in_parallel(container, orders::middle_out, threads, visits) ==
+              std::vector<int>(container.begin_middle_out_order(), container.end_middle_out_order()));
+        CHECK(visits == 10007);
+    }
+
+    SUBCASE("Exceptions reach the caller") {
+        CHECK_THROWS_AS(container.parallel_for_each(orders::ascending, [](size_t position, const int&) {
+            if (position == 4321) throw std::runtime_error("scoring failed");
+        }, 4), std::runtime_error);
+    }
+
+    SUBCASE("Empty containers call nothing") {
+        MyContainer<int> empty;
+        size_t calls = 0;
+        empty.parallel_for_each(orders::middle_out, [&calls](size_t, const int&) { ++calls; });
+        CHECK(calls == 0);
+    }
+}
+
+TEST_CASE("Top-k and Partial Orders") {
+    MyContainer<int> container;
+    for (int v : {42, 7, 19, 7, 88, -3, 56, 19, 0, 100}) {
+        container.add(v);
+    }
+
+    auto first_k = [](MyContainer<int>::AscendingOrder it) {
+        std::vector<int> out;
+        for (; it != EndSentinel(); ++it) out.push_back(*it);
+        return out;
+    };
+
+    SUBCASE("Smallest and largest k") {
+        CHECK(first_k(container.begin_ascending_order(4)) == std::vector<int>({-3, 0, 7, 7}));
+        std::vector<int> largest;
+        for (auto it = container.begin_descending_order(3); it != container.end_sentinel(); ++it) {
+            largest.push_back(*it);
+        }
+        CHECK(largest == std::vector<int>({100, 88, 56}));
+        CHECK(container.top_k(2) == std::vector<int>({100, 88}));
+        CHECK(container.top_k(0).empty());
+        CHECK(container.top_k(50).size() == 10); // k is clamped to size()
+        CHECK(first_k(container.begin_ascending_order(0)).empty());
+        auto it = container.begin_ascending_order(5);
+        CHECK(it[4] == 19);
+    }
+
+    SUBCASE("end_ascending_order(k) pairs with begin_ascending_order(k)") {
+        // Pairing begin_ascending_order(k) with end_ascending_order() would run past the k
+        // selected elements; debug builds assert on that comparison instead
+        std::vector<int> smallest(container.begin_ascending_order(4), container.end_ascending_order(4));
+        CHECK(smallest == std::vector<int>({-3, 0, 7, 7}));
+        std::vector<int> largest(container.begin_descending_order(3), container.end_descending_order(3));
+        CHECK(largest == std::vector<int>({100, 88, 56}));
+        CHECK(container.end_ascending_order(4) - container.begin_ascending_order(4) == 4);
+        CHECK(container.end_ascending_order(4) == container.end_sentinel());
+        CHECK(container.end_descending_order(50) - container.begin_descending_order(50) == 10);
+
+        // The end shares the view the begin built, so it selects nothing again
+        auto first = container.begin_ascending_order(5);
+        size_t before = heap_allocations;
+        auto last = container.end_ascending_order(5);
+        CHECK(heap_allocations == before);
+        CHECK(last - first == 5);
+
+        // Each k gets its own view, which the next change replaces
+        CHECK(std::vector<int>(container.begin_ascending_order(2), container.end_ascending_order(2)) ==
+              std::vector<int>({-3, 0}));
+        container.add(-10);
+        CHECK(std::vector<int>(container.begin_ascending_order(2), container.end_ascending_order(2)) ==
+              std::vector<int>({-10, -3}));
+    }
+
+    SUBCASE("Sliced from a current cached view") {
+        container.begin_ascending_order(); // builds the full view
+        CHECK(first_k(container.begin_ascending_order(3)) == std::vector<int>({-3, 0, 7}));
+        CHECK(container.top_k(3) == std::vector<int>({100, 88, 56}));
+        container.remove(100);
+        CHECK(container.top_k(1) == std::vector<int>({88}));
+    }
+
+    SUBCASE("Index snapshots and inline storage") {
+        MyContainer<Person> people;
+        people.add(Person{"Ann", 40});
+        people.add(Person{"Ben", 18});
+        people.add(Person{"Cid", 65});
+        people.add(Person{"Dee", 33});
+        std::vector<Person> oldest = people.top_k(2);
+        CHECK(oldest == std::vector<Person>({Person{"Cid", 65}, Person{"Ann", 40}}));
+        CHECK(people.begin_ascending_order(1)->name == "Ben");
+        for (int age = 0; age < 100; ++age) {
+            people.add(Person{"x", (age * 37) % 100}); // enough people for the heap selection
+        }
+        CHECK(people.top_k(2) == std::vector<Person>({Person{"x", 99}, Person{"x", 98}}));
+        CHECK(people.begin_ascending_order(2)[1].age == 1);
+
+        MyContainer<int, InlineCapacity<16>> small;
+        for (int v : {9, 4, 6, 1}) {
+            small.add(v);
+        }
+        CHECK(small.top_k(2) == std::vector<int>({9, 6}));
+        CHECK(*small.begin_ascending_order(2) == 1);
+    }
+
+    SUBCASE("Matches a full sort on larger inputs") {
+        MyContainer<int> big;
+        std::vector<int> values;
+        unsigned state = 5;
+        for (int i = 0; i < 3000; ++i) {
+            state = state * 1103515245u + 12345u;
+            values.push_back(static_cast<int>(state % 1000));
+            big.add(values.back());
+        }
+        std::sort(values.begin(), values.end());
+        CHECK(first_k(big.begin_ascending_order(100)) == std::vector<int>(values.begin(), values.begin() + 100));
+        CHECK(big.top_k(100) == std::vector<int>(values.rbegin(), values.rbegin() + 100));
+    }
+}
+
+TEST_CASE("Lazy Ascending Order") {
+    MyContainer<int> container;
+    for (int v : {7, 15, 6, 1, 2, 15, -4}) {
+        container.add(v);
+    }
+
+    std::vector<int> lazy(container.begin_lazy_ascending_order(), container.end_lazy_ascending_order());
+    CHECK(lazy == std::vector<int>({-4, 1, 2, 6, 7, 15, 15}));
+
+    std::vector<int> first_three;
+    for (auto it = container.begin_lazy_ascending_order(); it != container.end_sentinel(); ++it) {
+        if (first_three.size() == 3) break;
+        first_three.push_back(*it);
+    }
+    CHECK(first_three == std::vector<int>({-4, 1, 2}));
+
+    SUBCASE("Copies share one heap") {
+        auto it = container.begin_lazy_ascending_order();
+        auto previous = it++;
+        CHECK(*previous == -4);
+        CHECK(*it == 1);
+        CHECK(*it++ == 1);
+        auto copy = it;
+        ++copy;
+        CHECK(*copy == 6);
+        CHECK(*it == 6);
+        CHECK(copy == it);
+        CHECK(std::distance(it, container.end_lazy_ascending_order()) == 4);
+        CHECK(it == container.end_sentinel());
+    }
+
+    SUBCASE("Empty containers and index payloads") {
+        MyContainer<int> empty;
+        CHECK(empty.begin_lazy_ascending_order() == empty.end_lazy_ascending_order());
+        CHECK(empty.begin_lazy_ascending_order() == empty.end_sentinel());
+
+        MyContainer<Person> people;
+        people.add(Person{"Ann", 40});
+        people.add(Person{"Ben", 18});
+        people.add(Person{"Cid", 65});
+        auto youngest = people.begin_lazy_ascending_order();
+        CHECK(youngest->name == "Ben");
+        CHECK((++youngest)->name == "Ann");
+    }
+
+    SUBCASE("Matches the sorted view on larger inputs") {
+        MyContainer<int> big;
+        unsigned state = 9;
+        for (int i = 0; i < 5000; ++i) {
+            state = state * 1103515245u + 12345u;
+            big.add(static_cast<int>(state % 700));
+        }
+        std::vector<int> lazy_big(big.begin_lazy_ascending_order(), big.end_lazy_ascending_order());
+        std::vector<int> sorted(big.begin_ascending_order(), big.end_ascending_order());
+        CHECK(lazy_big == sorted);
+
+        MyContainer<int, InlineCapacity<8>> inline_big;
+        inline_big.add_range(sorted.rbegin(), sorted.rbegin() + 40);
+        CHECK(*inline_big.begin_lazy_ascending_order() == sorted[sorted.size() - 40]);
+    }
+}
+
+TEST_CASE("Order Views") {
+    MyContainer<int> container;
+    for (int v : {7, 15, 6, 1, 2}) {
+        container.add(v);
+    }
+
+    std::vector<int> asc;
+    for (int v : container.ascending()) {
+        asc.push_back(v);
+    }
+    CHECK(asc == std::vector<int>({1, 2, 6, 7, 15}));
+    auto reversed = container.reversed();
+    CHECK(std::vector<int>(reversed.begin(), reversed.end()) == std::vector<int>({2, 1, 6, 15, 7}));
+    auto descending = container.descending();
+    CHECK(std::vector<int>(descending.begin(), descending.end()) == std::vector<int>({15, 7, 6, 2, 1}));
+    auto cross = container.side_cross();
+    CHECK(std::vector<int>(cross.begin(), cross.end()) == std::vector<int>({1, 15, 2, 7, 6}));
+    auto middle = container.middle_out();
+    CHECK(std::vector<int>(middle.begin(), middle.end()) == std::vector<int>({6, 15, 1, 7, 2}));
+    CHECK(middle.size() == 5);
+    CHECK(middle.begin() != container.end_sentinel());
+
+    SUBCASE("take and drop fold into the order view") {
+        auto smallest = container.ascending() | views::take(3);
+        CHECK(std::vector<int>(smallest.begin(), smallest.end()) == std::vector<int>({1, 2, 6}));
+        auto largest = container.descending() | views::take(2);
+        CHECK(std::vector<int>(largest.begin(), largest.end()) == std::vector<int>({15, 7}));
+        auto window = container.ascending() | views::drop(1) | views::take(2);
+        CHECK(std::vector<int>(window.begin(), window.end()) == std::vector<int>({2, 6}));
+        auto tail = container.middle_out() | views::take(4) | views::drop(2);
+        CHECK(std::vector<int>(tail.begin(), tail.end()) == std::vector<int>({1, 7}));
+        CHECK((container.side_cross() | views::take(100)).size() == 5);
+        CHECK((container.ascending() | views::drop(9)).empty());
+        CHECK((container.ascending() | views::take(0)).empty());
+    }
+
+    SUBCASE("A limited sorted view only sorts what it reaches") {
+        MyContainer<int> big;
+        for (int i = 0; i < 4096; ++i) {
+            big.add((i * 7919) % 4096);
+        }
+        // The snapshot behind a limited view ends where the view does
+        auto first = (big.ascending() | views::take(4)).begin();
+        CHECK(first[3] == 3);
+        CHECK(first + 4 == big.end_sentinel());
+        auto top = big.descending() | views::drop(1) | views::take(2);
+        CHECK(std::vector<int>(top.begin(), top.end()) == std::vector<int>({4094, 4093}));
+        CHECK(top.begin() + 2 == big.end_sentinel());
+        auto all = big.ascending();
+        CHECK(all.begin() + 4096 == big.end_sentinel());
+    }
+
+    SUBCASE("A kept view starts over after the container changes") {
+        auto kept_reversed = container.reversed();
+        auto kept_middle = container.middle_out();
+        auto kept_smallest = container.ascending() | views::take(2);
+        CHECK(std::vector<int>(kept_reversed.begin(), kept_reversed.end()) == std::vector<int>({2, 1, 6, 15, 7}));
+        CHECK(std::vector<int>(kept_smallest.begin(), kept_smallest.end()) == std::vector<int>({1, 2}));
+        CHECK(kept_middle.size() == 5);
+
+        // Enough adds to reallocate the elements the first iterators pointed into
+        for (int v = 100; v < 164; ++v) {
+            container.add(v);
+        }
+        container.add(-3);
+        container.remove(7);
+        std::vector<int> expected_reversed(container.begin_reverse_order(), container.end_reverse_order());
+        CHECK(std::vector<int>(kept_reversed.begin(), kept_reversed.end()) == expected_reversed);
+        CHECK(std::vector<int>(kept_smallest.begin(), kept_smallest.end()) == std::vector<int>({-3, 1}));
+        std::vector<int> expected_middle(container.begin_middle_out_order(), container.end_middle_out_order());
+        CHECK(std::vector<int>(kept_middle.begin(), kept_middle.end()) == expected_middle);
+        CHECK(kept_middle.size() == 69);
+
+        container.remove(-3);
+        CHECK(*kept_smallest.begin() == 1);
+    }
+
+    SUBCASE("A kept view starts over after the storage moves") {
+        auto kept_reversed = container.reversed();
+        auto kept_middle = container.middle_out();
+        auto kept_smallest = container.ascending() | views::take(2);
+        CHECK(std::vector<int>(kept_reversed.begin(), kept_reversed.end()) == std::vector<int>({2, 1, 6, 15, 7}));
+        CHECK(kept_middle.size() == 5);
+        CHECK(std::vector<int>(kept_smallest.begin(), kept_smallest.end()) == std::vector<int>({1, 2}));
+
+        // reserve() and shrink_to_fit() reallocate without changing the elements
+        container.reserve(1000);
+        CHECK(std::vector<int>(kept_reversed.begin(), kept_reversed.end()) == std::vector<int>({2, 1, 6, 15, 7}));
+        CHECK(std::vector<int>(kept_middle.begin(), kept_middle.end()) == std::vector<int>({6, 15, 1, 7, 2}));
+        container.shrink_to_fit();
+        CHECK(std::vector<int>(kept_reversed.begin(), kept_reversed.end()) == std::vector<int>({2, 1, 6, 15, 7}));
+        CHECK(std::vector<int>(kept_middle.begin(), kept_middle.end()) == std::vector<int>({6, 15, 1, 7, 2}));
+
+        // An assigned container can arrive with the same version as the one it replaces
+        MyContainer<int> other = container;
+        other.remove(15);
+        container.add(4);
+        CHECK(std::vector<int>(kept_smallest.begin(), kept_smallest.end()) == std::vector<int>({1, 2}));
+        container = other;
+        CHECK(std::vector<int>(kept_reversed.begin(), kept_reversed.end()) == std::vector<int>({2, 1, 6, 7}));
+        std::vector<int> expected_middle(other.begin_middle_out_order(), other.end_middle_out_order());
+        CHECK(std::vector<int>(kept_middle.begin(), kept_middle.end()) == expected_middle);
+        CHECK(std::vector<int>(kept_smallest.begin(), kept_smallest.end()) == std::vector<int>({1, 2}));
+        container = MyContainer<int>();
+        CHECK(kept_reversed.empty());
+        CHECK(kept_smallest.empty());
+    }
+
+    SUBCASE("filter and transform compose lazily") {
+        std::vector<int> odd_squares;
+        for (int v : container.ascending() | views::filter([](int v) { return v % 2 != 0; })
+                                           | views::transform([](int v) { return v * v; })) {
+            odd_squares.push_back(v);
+        }
+        CHECK(odd_squares == std::vector<int>({1, 49, 225}));
+
+        auto first_even = container.middle_out() | views::filter([](int v) { return v % 2 == 0; }) | views::take(1);
+        CHECK(std::vector<int>(first_even.begin(), first_even.end()) == std::vector<int>({6}));
+
+        auto skipped = container.reversed() | views::transform([](int v) { return v + 1; }) | views::drop(3);
+        CHECK(std::vector<int>(skipped.begin(), skipped.end()) == std::vector<int>({16, 8}));
+
+        int calls = 0;
+        auto counted = container.ascending() | views::filter([&calls](int v) { ++calls; return v > 1; });
+        CHECK(calls == 0);
+        CHECK(*counted.begin() == 2);
+        CHECK(calls == 2);
+
+        MyContainer<Person> people;
+        people.add(Person{"Ann", 40});
+        people.add(Person{"Ben", 18});
+        people.add(Person{"Cid", 65});
+        std::vector<std::string> names;
+        for (const std::string& name : people.descending() | views::take(2)
+                                                         | views::transform([](const Person& p) -> const std::string& { return p.name; })) {
+            names.push_back(name);
+        }
+        CHECK(names == std::vector<std::string>({"Cid", "Ann"}));
+    }
+}
+
+TEST_CASE("Concurrent Container") {
+    ConcurrentMyContainer<int> shared;
+    CHECK(shared.size() == 0);
+    for (int v : {7, 15, 6}) {
+        shared.add(v);
+    }
+    auto before = shared.snapshot();
+    shared.update([](MyContainer<int>& c) {
+        c.add(1);
+        c.add(2);
+    });
+    auto after = shared.snapshot();
+
+    SUBCASE("Snapshots are immutable") {
+        CHECK(before->size() == 3);
+        std::vector<int> old_asc(before->begin_ascending_order(), before->end_ascending_order());
+        CHECK(old_asc == std::vector<int>({6, 7, 15}));
+        std::vector<int> asc(after->begin_ascending_order(), after->end_ascending_order());
+        CHECK(asc == std::vector<int>({1, 2, 6, 7, 15}));
+        std::vector<int> mid(after->begin_middle_out_order(), after->end_middle_out_order());
+        CHECK(mid == std::vector<int>({6, 15, 1, 7, 2}));
+        auto cross = after->side_cross();
+        CHECK(std::vector<int>(cross.begin(), cross.end()) == std::vector<int>({1, 15, 2, 7, 6}));
+    }
+
+    SUBCASE("Removal and batches") {
+        CHECK(shared.try_remove(15) == 1);
+        CHECK(shared.try_remove(15) == 0);
+        CHECK_THROWS_AS(shared.remove(42), std::invalid_argument);
+        std::vector<int> batch = {1, 2};
+        CHECK(shared.erase_many(batch.begin(), batch.end()) == 2);
+        std::vector<int> more = {9, 3};
+        shared.add_range(more.begin(), more.end());
+        CHECK(shared.snapshot()->top_k(2) == std::vector<int>({9, 7}));
+        CHECK(after->size() == 5);
+
+        // A hash index leaves tombstones that are compacted before publishing
+        shared.update([](MyContainer<int>& c) {
+            c.enable_hash_index();
+            c.maintain_sorted_index();
+            c.remove(7);
+        });
+        auto snap = shared.snapshot();
+        std::vector<int> asc(snap->begin_ascending_order(), snap->end_ascending_order());
+        CHECK(asc == std::vector<int>({3, 6, 9}));
+        CHECK_THROWS_AS(shared.update([](MyContainer<int>& c) { c.remove(100); }), std::invalid_argument);
+        CHECK(shared.size() == 3);
+
+        // A batch that throws halfway is neither published nor kept for the next batch
+        CHECK_THROWS_AS(shared.update([](MyContainer<int>& c) {
+            c.add(50);
+            c.remove(3);
+            c.remove(100);
+        }), std::invalid_argument);
+        CHECK(shared.snapshot() == snap);
+        shared.add(1);
+        auto next = shared.snapshot();
+        std::vector<int> order(next->begin_order(), next->end_order());
+        CHECK(order == std::vector<int>({6, 9, 3, 1}));
+        std::vector<int> sorted(next->begin_ascending_order(), next->end_ascending_order());
+        CHECK(sorted == std::vector<int>({1, 3, 6, 9}));
+        CHECK(shared.try_remove(9) == 1);
+        CHECK(shared.size() == 3);
+    }
+
+    SUBCASE("Snapshots share the sorted view and leave the hash index behind") {
+        shared.update([](MyContainer<int>& c) {
+            c.enable_hash_index();
+            c.remove(15);
+        });
+        auto snap = shared.snapshot();
+        // The maintained view is shared, so readers sort nothing
+        size_t before_read = heap_allocations;
+        std::vector<int> asc;
+        asc.reserve(4);
+        asc.assign(snap->begin_ascending_order(), snap->end_ascending_order());
+        CHECK(heap_allocations == before_read + 1);
+        CHECK(asc == std::vector<int>({1, 2, 6, 7}));
+
+        // A snapshot copy is one element buffer: no index, tombstones or sorted view copied
+        MyContainer<int> indexed;
+        indexed.enable_hash_index();
+        indexed.maintain_sorted_index();
+        for (int i = 0; i < 100; ++i) {
+            indexed.add(i % 10);
+        }
+        indexed.begin_ascending_order();
+        indexed.remove(3);
+        size_t before_copy = heap_allocations;
+        MyContainer<int> copy = indexed.snapshot_copy();
+        CHECK(heap_allocations == before_copy + 1);
+        CHECK(copy.size() == 90);
+        CHECK(std::find(copy.begin(), copy.end(), 3) == copy.end());
+        std::vector<int> copied(copy.begin_ascending_order(), copy.end_ascending_order());
+        CHECK(copied.size() == 90);
+        CHECK(std::is_sorted(copied.begin(), copied.end()));
+        CHECK(copy.try_remove(4) == 10);
+        CHECK(indexed.try_remove(4) == 10);
+        CHECK(std::count(indexed.begin(), indexed.end(), 3) == 0);
+        CHECK(indexed.size() == 80);
+    }
+
+    SUBCASE("A warmed plain container may be read by several threads") {
+        MyContainer<int> plain;
+        for (int i = 0; i < 1000; ++i) {
+            plain.add((i * 37) % 1000);
+        }
+        plain.begin_ascending_order();
+        std::atomic<size_t> bad(0);
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&plain, &bad]() {
+                for (int round = 0; round < 20; ++round) {
+                    std::vector<int> smallest(plain.begin_ascending_order(3), plain.end_ascending_order(3));
+                    if (!std::is_sorted(plain.begin_ascending_order(), plain.end_ascending_order()) ||
+                        plain.top_k(2) != std::vector<int>({999, 998}) || smallest != std::vector<int>({0, 1, 2})) {
+                        ++bad;
+                    }
+                }
+            });
+        }
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        CHECK(bad == 0);
+    }
+
+    SUBCASE("Readers iterate while a writer publishes") {
+        std::atomic<bool> done(false);
+        std::atomic<size_t> bad(0);
+        std::atomic<size_t> reads(0);
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&shared, &done, &bad, &reads]() {
+                do {
+                    auto snap = shared.snapshot();
+                    std::vector<int> asc(snap->begin_ascending_order(), snap->end_ascending_order());
+                    size_t middle = static_cast<size_t>(std::distance(snap->begin_middle_out_order(), snap->end_middle_out_order()));
+                    if (!std::is_sorted(asc.begin(), asc.end()) || asc.size() != middle ||
+                        asc.size() != static_cast<size_t>(snap->size())) {
+                        ++bad;
+                    }
+                    // Partial views and the lazy order only read a published snapshot
+                    const size_t k = std::min<size_t>(3, asc.size());
+                    std::vector<int> top = snap->top_k(3);
+                    std::vector<int> smallest(snap->begin_ascending_order(3), snap->end_ascending_order(3));
+                    auto taken = snap->ascending() | views::take(3);
+                    std::vector<int> viewed(taken.begin(), taken.end());
+                    std::vector<int> lazy;
+                    for (auto it = snap->begin_lazy_ascending_order(); lazy.size() < k; ++it) {
+                        lazy.push_back(*it);
+                    }
+                    const std::vector<int> expected(asc.begin(), asc.begin() + k);
+                    if (!std::equal(top.begin(), top.end(), asc.rbegin()) || top.size() != k ||
+                        smallest != expected || viewed != expected || lazy != expected) {
+                        ++bad;
+                    }
+                    ++reads;
+                } while (!done);
+            });
+        }
+        for (int batch = 0; batch < 200; ++batch) {
+            shared.update([batch](MyContainer<int>& c) {
+                for (int i = 0; i < 10; ++i) {
+                    c.add((batch * 37 + i * 11) % 101);
+                }
+                c.try_remove(batch % 101);
+            });
+        }
+        done = true;
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        CHECK(bad == 0);
+        CHECK(reads >= 4);
+        auto final_view = shared.snapshot();
+        CHECK(std::is_sorted(final_view->begin_ascending_order(), final_view->end_ascending_order()));
+    }
+}
+
+#if defined(CONTAINER_HAS_PMR)
+// Counts the allocations a pmr container makes through its memory resource
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+#endif
+
+TEST_CASE("Newer Standard Fast Paths") {
+    SUBCASE("Comparison sorts with an implementation-chosen thread count") {
+        std::vector<std::string> words;
+        for (int i = 0; i < 3000; ++i) {
+            words.push_back(std::to_string((i * 7919) % 613));
+        }
+        std::vector<std::string> expected = words;
+        std::sort(expected.begin(), expected.end());
+        parallel_comparison_sort(words.data(), words.data() + words.size(),
+                                 [](const std::string& a, const std::string& b) { return a < b; },
+                                 ParallelPolicy(0, 100));
+        CHECK(words == expected);
+
+        MyContainer<std::string> strings;
+        strings.add_range(expected.rbegin(), expected.rend());
+        std::vector<std::string> asc(strings.begin_ascending_order(ParallelPolicy(0, 100)), strings.end_ascending_order());
+        CHECK(asc == expected);
+    }
+
+#if defined(CONTAINER_HAS_PMR)
+    SUBCASE("pmr containers draw their snapshots from the memory resource") {
+        CountingResource resource;
+        pmr::MyContainer<int> container{std::pmr::polymorphic_allocator<int>(&resource)};
+        for (int v : {7, 15, 6, 1, 2}) {
+            container.add(v);
+        }
+        size_t before = resource.allocations;
+        std::vector<int> asc(container.begin_ascending_order(), container.end_ascending_order());
+        CHECK(asc == std::vector<int>({1, 2, 6, 7, 15}));
+        CHECK(resource.allocations > before);
+
+        std::pmr::unsynchronized_pool_resource pool;
+        pmr::MyContainer<std::string> pooled{std::pmr::polymorphic_allocator<std::string>(&pool)};
+        pooled.add("b");
+        pooled.add("a");
+        CHECK(*pooled.begin_ascending_order() == "a");
+    }
+#endif
+
+#if defined(CONTAINER_HAS_RANGES)
+    SUBCASE("The orders are C++20 ranges ending in std::default_sentinel") {
+        using C = MyContainer<int>;
+        static_assert(std::random_access_iterator<C::AscendingOrder>, "AscendingOrder is random access");
+        static_assert(std::random_access_iterator<C::MiddleOutOrder>, "MiddleOutOrder is random access");
+        static_assert(std::input_iterator<C::LazyAscendingOrder>, "LazyAscendingOrder is an input iterator");
+        static_assert(std::sentinel_for<std::default_sentinel_t, C::SideCrossOrder>, "default_sentinel ends the orders");
+
+        C container;
+        for (int v : {7, 15, 6, 1, 2}) {
+            container.add(v);
+        }
+        CHECK(container.begin_descending_order() != std::default_sentinel);
+        auto ascending = container.range_in(orders::ascending);
+        CHECK(std::ranges::size(ascending) == 5);
+        std::vector<int> smallest;
+        for (int v : ascending | std::views::take(3)) {
+            smallest.push_back(v);
+        }
+        CHECK(smallest == std::vector<int>({1, 2, 6}));
+        CHECK(std::ranges::equal(container.range_in(orders::middle_out), std::vector<int>({6, 15, 1, 7, 2})));
+        CHECK(std::ranges::is_sorted(container.range_in(orders::ascending)));
+
+        // Every order tag gives a sized range that the standard views accept
+        auto first_two = [](auto range) {
+            CHECK(std::ranges::size(range) == 5);
+            auto taken = range | std::views::take(2);
+            return std::vector<int>(taken.begin(), taken.end());
+        };
+        CHECK(first_two(container.range_in(orders::insertion)) == std::vector<int>({7, 15}));
+        CHECK(first_two(container.range_in(orders::reverse)) == std::vector<int>({2, 1}));
+        CHECK(first_two(container.range_in(orders::ascending)) == std::vector<int>({1, 2}));
+        CHECK(first_two(container.range_in(orders::descending)) == std::vector<int>({15, 7}));
+        CHECK(first_two(container.range_in(orders::side_cross)) == std::vector<int>({1, 15}));
+        CHECK(first_two(container.range_in(orders::middle_out)) == std::vector<int>({6, 15}));
+        CHECK(std::ranges::equal(container.range_in(orders::reverse) | std::views::reverse,
+                                 container.range_in(orders::insertion)));
+    }
+#endif
+}
@@ -0,0 +1,299 @@
+// meirshuker15@gmail.com
+//Views.hpp
+//Description: Lazy view adaptors for MyContainer's orders: take, drop, filter and transform.
+//Views compose with operator|, e.g. c.ascending() | views::take(10), and do no work until
+//begin() is called. MyContainer's own order views handle take and drop themselves, so a
+//sorted order limited to k elements only sorts k of them.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace container {
+namespace views {
+
+    /// @brief The adaptor made by take(n): keeps at most n elements.
+    struct TakeAdaptor {
+        size_t count;
+    };
+
+    /// @brief The adaptor made by drop(n): skips the first n elements.
+    struct DropAdaptor {
+        size_t count;
+    };
+
+    /// @brief The adaptor made by filter(pred): keeps the elements for which pred is true.
+    template<typename Pred>
+    struct FilterAdaptor {
+        Pred pred;
+    };
+
+    /// @brief The adaptor made by transform(fn): yields fn(element) for every element.
+    template<typename Fn>
+    struct TransformAdaptor {
+        Fn fn;
+    };
+
+    inline TakeAdaptor take(size_t count) { return TakeAdaptor{count}; }
+    inline DropAdaptor drop(size_t count) { return DropAdaptor{count}; }
+
+    template<typename Pred>
+    FilterAdaptor<typename std::decay<Pred>::type> filter(Pred&& pred) {
+        return FilterAdaptor<typename std::decay<Pred>::type>{std::forward<Pred>(pred)};
+    }
+
+    template<typename Fn>
+    TransformAdaptor<typename std::decay<Fn>::type> transform(Fn&& fn) {
+        return TransformAdaptor<typename std::decay<Fn>::type>{std::forward<Fn>(fn)};
+    }
+
+    namespace detail {
+
+        /// @brief Advances it by up to n steps, stopping at last.
+        template<typename It>
+        It advance_within(It it, It last, size_t n, std::random_access_iterator_tag) {
+            return it + static_cast<std::ptrdiff_t>(std::min<size_t>(n, static_cast<size_t>(last - it)));
+        }
+
+        template<typename It>
+        It advance_within(It it, It last, size_t n, std::input_iterator_tag) {
+            for (; n > 0 && it != last; --n) {
+                ++it;
+            }
+            return it;
+        }
+
+        template<typename It>
+        It advance_within(It it, It last, size_t n) {
+            return advance_within(it, last, n, typename std::iterator_traits<It>::iterator_category());
+        }
+    } // namespace detail
+
+    /*===============================================
+    Take
+    ===============================================*/
+
+    /// @brief Counts down the elements a TakeView has left to yield.
+    template<typename It>
+    class TakeIterator {
+    private:
+        It current;
+        size_t remaining = 0;
+    public:
+        using iterator_category = typename std::conditional<
+            std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value,
+            std::forward_iterator_tag, std::input_iterator_tag>::type;
+        using value_type = typename std::iterator_traits<It>::value_type;
+        using difference_type = typename std::iterator_traits<It>::difference_type;
+        using pointer = typename std::iterator_traits<It>::pointer;
+        using reference = typename std::iterator_traits<It>::reference;
+
+        TakeIterator() = default;
+        TakeIterator(It current, size_t remaining) : current(current), remaining(remaining) {}
+
+        reference operator*() const { return *current; }
+        pointer operator->() const { return &*current; }
+
+        TakeIterator& operator++() {
+            ++current;
+            --remaining;
+            return *this;
+        }
+
+        TakeIterator operator++(int) {
+            TakeIterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        /// @brief Equal when both have run out, or both stand on the same base element.
+        bool operator==(const TakeIterator& other) const {
+            return (remaining == 0 && other.remaining == 0) || current == other.current;
+        }
+        bool operator!=(const TakeIterator& other) const { return !(*this == other); }
+    };
+
+    /// @brief The first count elements of a view.
+    template<typename Base>
+    class TakeView {
+    private:
+        Base base;
+        size_t count;
+    public:
+        using iterator = TakeIterator<typename Base::iterator>;
+
+        TakeView(Base base, size_t count) : base(std::move(base)), count(count) {}
+
+        iterator begin() const { return iterator(base.begin(), count); }
+        iterator end() const { return iterator(base.end(), 0); }
+    };
+
+    /*===============================================
+    Drop
+    ===============================================*/
+
+    /// @brief A view without its first count elements.
+    template<typename Base>
+    class DropView {
+    private:
+        Base base;
+        size_t count;
+    public:
+        using iterator = typename Base::iterator;
+
+        DropView(Base base, size_t count) : base(std::move(base)), count(count) {}
+
+        iterator begin() const { return detail::advance_within(base.begin(), base.end(), count); }
+        iterator end() const { return base.end(); }
+    };
+
+    /*===============================================
+    Filter
+    ===============================================*/
+
+    /// @brief Steps over the base elements that fail the predicate.
+    /// @details Points to the FilterView's predicate, so it is valid while the view lives.
+    template<typename It, typename Pred>
+    class FilterIterator {
+    private:
+        It current;
+        It last;
+        const Pred* pred = nullptr;
+
+        void skip() {
+            while (current != last && !(*pred)(*current)) {
+                ++current;
+            }
+        }
+    public:
+        using iterator_category = typename std::conditional<
+            std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value,
+            std::forward_iterator_tag, std::input_iterator_tag>::type;
+        using value_type = typename std::iterator_traits<It>::value_type;
+        using difference_type = typename std::iterator_traits<It>::difference_type;
+        using pointer = typename std::iterator_traits<It>::pointer;
+        using reference = typename std::iterator_traits<It>::reference;
+
+        FilterIterator() = default;
+        FilterIterator(It current, It last, const Pred& pred) : current(current), last(last), pred(&pred) { skip(); }
+
+        reference operator*() const { return *current; }
+        pointer operator->() const { return &*current; }
+
+        FilterIterator& operator++() {
+            ++current;
+            skip();
+            return *this;
+        }
+
+        FilterIterator operator++(int) {
+            FilterIterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const FilterIterator& other) const { return current == other.current; }
+        bool operator!=(const FilterIterator& other) const { return current != other.current; }
+    };
+
+    /// @brief The elements of a view for which a predicate holds.
+    template<typename Base, typename Pred>
+    class FilterView {
+    private:
+        Base base;
+        Pred pred;
+    public:
+        using iterator = FilterIterator<typename Base::iterator, Pred>;
+
+        FilterView(Base base, Pred pred) : base(std::move(base)), pred(std::move(pred)) {}
+
+        iterator begin() const { return iterator(base.begin(), base.end(), pred); }
+        iterator end() const { return iterator(base.end(), base.end(), pred); }
+    };
+
+    /*===============================================
+    Transform
+    ===============================================*/
+
+    /// @brief Yields fn(element) for every base element.
+    /// @details Points to the TransformView's function, so it is valid while the view lives.
+    ///          A function that returns by value makes this an input iterator.
+    template<typename It, typename Fn>
+    class TransformIterator {
+    private:
+        It current;
+        const Fn* fn = nullptr;
+    public:
+        using reference = decltype(std::declval<const Fn&>()(*std::declval<It>()));
+        using iterator_category = typename std::conditional<
+            std::is_reference<reference>::value &&
+            std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<It>::iterator_category>::value,
+            std::forward_iterator_tag, std::input_iterator_tag>::type;
+        using value_type = typename std::decay<reference>::type;
+        using difference_type = typename std::iterator_traits<It>::difference_type;
+        using pointer = void;
+
+        TransformIterator() = default;
+        TransformIterator(It current, const Fn& fn) : current(current), fn(&fn) {}
+
+        reference operator*() const { return (*fn)(*current); }
+
+        TransformIterator& operator++() {
+            ++current;
+            return *this;
+        }
+
+        TransformIterator operator++(int) {
+            TransformIterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const TransformIterator& other) const { return current == other.current; }
+        bool operator!=(const TransformIterator& other) const { return current != other.current; }
+    };
+
+    /// @brief A view of fn applied to every element of a base view.
+    template<typename Base, typename Fn>
+    class TransformView {
+    private:
+        Base base;
+        Fn fn;
+    public:
+        using iterator = TransformIterator<typename Base::iterator, Fn>;
+
+        TransformView(Base base, Fn fn) : base(std::move(base)), fn(std::move(fn)) {}
+
+        iterator begin() const { return iterator(base.begin(), fn); }
+        iterator end() const { return iterator(base.end(), fn); }
+    };
+
+    /*===============================================
+    Composition
+    ===============================================*/
+
+    template<typename Base>
+    TakeView<Base> operator|(Base base, TakeAdaptor adaptor) {
+        return TakeView<Base>(std::move(base), adaptor.count);
+    }
+
+    template<typename Base>
+    DropView<Base> operator|(Base base, DropAdaptor adaptor) {
+        return DropView<Base>(std::move(base), adaptor.count);
+    }
+
+    template<typename Base, typename Pred>
+    FilterView<Base, Pred> operator|(Base base, FilterAdaptor<Pred> adaptor) {
+        return FilterView<Base, Pred>(std::move(base), std::move(adaptor.pred));
+    }
+
+    template<typename Base, typename Fn>
+    TransformView<Base, Fn> operator|(Base base, TransformAdaptor<Fn> adaptor) {
+        return TransformView<Base, Fn>(std::move(base), std::move(adaptor.fn));
+    }
+} // namespace views
+} // namespace container